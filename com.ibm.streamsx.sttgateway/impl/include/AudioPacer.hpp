@@ -0,0 +1,103 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_AUDIOPACER_HPP_
+#define COM_IBM_STREAMS_STTGATEWAY_AUDIOPACER_HPP_
+
+#include <string>
+#include <chrono>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+// Get the byte rate (bytes per second) of the raw audio formats from the content type
+// e.g. audio/l16;rate=16000 or audio/mulaw;rate=8000;channels=2
+// Returns 0.0 if the byte rate can not be derived from the content type (compressed formats and formats
+// with a header like audio/wav)
+inline double getAudioByteRate(const std::string & contentType) {
+	std::string ct;
+	for (char c : contentType)
+		if (not std::isspace(static_cast<unsigned char>(c)))
+			ct.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+
+	std::string mediaType = ct.substr(0, ct.find(';'));
+	double bytesPerSample = 0.0;
+	double rate = 0.0;
+	double channels = 1.0;
+	if (mediaType == "audio/l16") {
+		bytesPerSample = 2.0;
+	} else if ((mediaType == "audio/mulaw") || (mediaType == "audio/alaw")) {
+		bytesPerSample = 1.0;
+	} else if (mediaType == "audio/basic") {
+		// single channel mulaw with 8000 samples per second
+		bytesPerSample = 1.0;
+		rate = 8000.0;
+	} else {
+		return 0.0;
+	}
+
+	std::string::size_type pos = ct.find(';');
+	while (pos != std::string::npos) {
+		std::string::size_type end = ct.find(';', pos + 1);
+		std::string param = ct.substr(pos + 1, (end == std::string::npos) ? std::string::npos : end - pos - 1);
+		if (param.compare(0, 5, "rate=") == 0)
+			rate = std::atof(param.c_str() + 5);
+		else if (param.compare(0, 9, "channels=") == 0)
+			channels = std::atof(param.c_str() + 9);
+		pos = end;
+	}
+	if ((rate <= 0.0) || (channels <= 0.0))
+		return 0.0;
+	return bytesPerSample * rate * channels;
+}
+
+/*
+ * Schedules the audio of one conversation against a monotonic clock
+ * The audio bytes are due at a constant byte rate starting with the first bytes of the conversation.
+ * If the audio arrives later than due (e.g. live audio), the schedule is moved forward and the
+ * late audio is not sent in a burst.
+ * The pacer is used from the sender thread only.
+ */
+class AudioPacer {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	AudioPacer() : start(), bytes(0) {}
+
+	// start a new conversation
+	void reset() { bytes = 0; }
+
+	// Get the time when the next len bytes are due to be sent and account for them
+	// bytesPerSecond must be greater than 0.0
+	// maxLag is the time in seconds, the audio may be late before the schedule is moved forward
+	Clock::time_point schedule(uint64_t len, double bytesPerSecond, double maxLag) {
+		Clock::time_point now = Clock::now();
+		if (bytes == 0) {
+			start = now;
+		} else {
+			Clock::time_point due = start + toDuration(bytes / bytesPerSecond);
+			if (now - due > toDuration(maxLag))
+				start = now - toDuration(bytes / bytesPerSecond);
+		}
+		Clock::time_point myDue = start + toDuration(bytes / bytesPerSecond);
+		bytes = bytes + len;
+		return myDue;
+	}
+
+private:
+	static Clock::duration toDuration(double seconds) {
+		return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+	}
+
+	// The start time of the schedule
+	Clock::time_point start;
+	// The number of bytes scheduled since the start
+	uint64_t bytes;
+};
+
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_AUDIOPACER_HPP_ */
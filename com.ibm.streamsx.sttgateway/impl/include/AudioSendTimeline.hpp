@@ -0,0 +1,85 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_AUDIOSENDTIMELINE_HPP_
+#define COM_IBM_STREAMS_STTGATEWAY_AUDIOSENDTIMELINE_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+/*
+ * Records when the audio of one conversation was sent to the STT service
+ * Each sent chunk is recorded with its end offset in the audio stream and the send time.
+ * The receiver thread gets the send time of an audio offset when the result of this audio arrives.
+ * The results arrive in the order of the audio, thus all chunks before the requested offset are discarded.
+ * The number of chunks is bounded; if no result arrives the oldest chunks are discarded.
+ * The chunks are recorded from the sender thread (and from the receiver thread when queued audio
+ * is flushed) and are read from the receiver thread; the access is serialized with a mutex.
+ */
+class AudioSendTimeline {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	// The maximum number of recorded chunks
+	static const size_t maxChunks = 4096;
+
+	AudioSendTimeline() : mutex(), chunks(), bytes(0), discarded(0) {}
+
+	// start a new conversation
+	void reset() {
+		std::lock_guard<std::mutex> lock(mutex);
+		chunks.clear();
+		bytes = 0;
+		discarded = 0;
+	}
+
+	// Account for len bytes which were sent at sendTime
+	void record(uint64_t len, Clock::time_point sendTime) {
+		if (len == 0)
+			return;
+		std::lock_guard<std::mutex> lock(mutex);
+		if (chunks.size() >= maxChunks) {
+			discarded = chunks.front().first;
+			chunks.pop_front();
+		}
+		bytes = bytes + len;
+		chunks.emplace_back(bytes, sendTime);
+	}
+
+	// Get the send time of the chunk which contains the last audio byte before endOffset (exclusive)
+	// Returns false if this audio was not yet sent or the chunk has already been discarded
+	bool getSendTime(uint64_t endOffset, Clock::time_point & sendTime) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if ((endOffset < discarded) || ((endOffset == discarded) && (endOffset > 0)))
+			return false;
+		// a chunk which ends at endOffset holds the last byte and is kept
+		while ( ! chunks.empty() && (chunks.front().first < endOffset)) {
+			discarded = chunks.front().first;
+			chunks.pop_front();
+		}
+		if (chunks.empty())
+			return false;
+		sendTime = chunks.front().second;
+		return true;
+	}
+
+private:
+	std::mutex mutex;
+	// The end offset (exclusive) and the send time of the recorded chunks
+	std::deque<std::pair<uint64_t, Clock::time_point>> chunks;
+	// The number of bytes recorded since the start of the conversation
+	uint64_t bytes;
+	// The end offset of the last discarded chunk
+	uint64_t discarded;
+};
+
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_AUDIOSENDTIMELINE_HPP_ */
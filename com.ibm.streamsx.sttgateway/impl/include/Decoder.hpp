@@ -28,6 +28,10 @@ namespace com { namespace ibm { namespace streams { namespace sttgateway {
  * Get the results with the various getter functions like:
  * DecoderAlternatives::getUtteranceText()
  * The results are available until the doWork is called.
+ *
+ * The result lists can be handed off to the output tuple with the release... functions.
+ * The released lists are swapped with the lists of the output tuple and are cleared with the next doWork,
+ * thus the lists are neither copied nor allocated again.
  */
 class Decoder : public DecoderState, public DecoderError, public DecoderResults, public DecoderResultIndex,  public DecoderSpeakerLabels {
 public:
@@ -51,7 +55,9 @@ public:
 		DecoderState::doWork();
 		DecoderResults::doWork();
 		DecoderResultIndex::doWork();
-		DecoderSpeakerLabels::doWork();
+		// speaker labels are requested and decoded only if a speaker output function is used
+		if (configuration.identifySpeakers)
+			DecoderSpeakerLabels::doWork();
 
 		SPLAPPTRC(L_TRACE, configuration.traceIntro << "-->dec stateListening: " << isListening(), WATSON_DECODER);
 		if (DecoderError::hasResult())
@@ -83,24 +89,29 @@ public:
 			SPLAPPTRC(L_TRACE, configuration.traceIntro << "-->dec confusion word: " << DecoderWordAlternatives::getWordAlternatives(), WATSON_DECODER);
 		}
 		if (DecoderKeywordsResult::hasResult()) {
-			const auto & kwresults = DecoderKeywordsResult::getKeywordsSpottingResults();
-			std::stringstream ss;
-			ss << "{";
-			for (const auto & kwentry : kwresults) {
-				ss << kwentry.first << ":";
-				const auto & emergences = kwentry.second;
-				ss << "[";
-				for (const auto & emergence : emergences) {
-					ss << "{start_time:" << emergence.start_time << ";end_time:" << emergence.end_time << ";confidence:" << emergence.confidence << "}";
-				}
-				ss << "],";
-			}
-			ss << "}";
-			SPLAPPTRC(L_TRACE, configuration.traceIntro << "-->dec keywords: " << ss.str(), WATSON_DECODER);
+			// the keyword string is built only if the trace level is enabled
+			SPLAPPTRC(L_TRACE, configuration.traceIntro << "-->dec keywords: " << keywordsToString(), WATSON_DECODER);
 		}
 
 		DecoderCommons::doWorkEnd();
 	}
+
+private:
+	std::string keywordsToString() const {
+		std::stringstream ss;
+		ss << "{";
+		for (const size_t idx : DecoderKeywordsResult::getKeywordHits()) {
+			ss << DecoderKeywordsResult::getKeyword(idx) << ":";
+			const auto & emergences = DecoderKeywordsResult::getKeywordEmergences(idx);
+			ss << "[";
+			for (const auto & emergence : emergences) {
+				ss << "{start_time:" << emergence.start_time << ";end_time:" << emergence.end_time << ";confidence:" << emergence.confidence << "}";
+			}
+			ss << "],";
+		}
+		ss << "}";
+		return ss.str();
+	}
 };
 
 }}}}
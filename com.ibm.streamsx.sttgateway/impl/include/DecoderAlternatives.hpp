@@ -7,6 +7,7 @@
 #define COM_IBM_STREAMS_STTGATEWAY_DECODER_ALTERNATIVES_H_
 
 #include "DecoderCommons.hpp"
+#include <utility>
 #include <vector>
 
 namespace com { namespace ibm { namespace streams { namespace sttgateway {
@@ -36,6 +37,14 @@ public:
 	const SPL::float64 &            getUtteranceStartTime() const noexcept        { return utteranceStartTime; }
 	const SPL::float64 &            getUtteranceEndTime() const noexcept          { return utteranceEndTime; }
 
+	// Hand off the results; the content is unspecified until the next doWork
+	SPL::rstring &&                 releaseUtteranceText() noexcept               { return std::move(utteranceText); }
+	SPL::list<SPL::rstring> &&      releaseUtteranceAlternatives() noexcept       { return std::move(utteranceAlternatives); }
+	SPL::list<SPL::rstring> &&      releaseUtteranceWords() noexcept              { return std::move(utteranceWords); }
+	SPL::list<SPL::float64> &&      releaseUtteranceWordsConfidences() noexcept   { return std::move(utteranceWordsConfidences); }
+	SPL::list<SPL::float64> &&      releaseUtteranceWordsStartTimes() noexcept    { return std::move(utteranceWordsStartTimes); }
+	SPL::list<SPL::float64> &&      releaseUtteranceWordsEndTimes() noexcept      { return std::move(utteranceWordsEndTimes); }
+
 protected:
 	DecoderAlternatives(const WatsonSTTConfig & config) :
 		DecoderCommons(config),
@@ -57,11 +66,11 @@ protected:
 		utteranceEndTime = 0.0;
 	}
 
-	void doWork(const rapidjson::Value& result, const std::string & parentName, rapidjson::SizeType resultIndex, bool final);
+	void doWork(const rapidjson::Value& result, const JsonPath & parentPath, rapidjson::SizeType resultIndex, bool final);
 
 private:
-	void doWorkTimestamps(const rapidjson::Value& result, const std::string & parentName, rapidjson::SizeType resultIndex);
-	void doWorkWordConfidence(const rapidjson::Value& result, const std::string & parentName, rapidjson::SizeType resultIndex);
+	void doWorkTimestamps(const rapidjson::Value& result, const JsonPath & parentPath, rapidjson::SizeType resultIndex);
+	void doWorkWordConfidence(const rapidjson::Value& result, const JsonPath & parentPath, rapidjson::SizeType resultIndex);
 };
 
 // Decode confidence: not delivered in sttResultMode == WatsonSTTConfig::complete
@@ -71,24 +80,22 @@ private:
 //						and for the first result! no concatenation
 // Decode timestamps: concatenate all results of the first alternative
 // Decode word confidences: concatenate all final results of the first alternative
-void DecoderAlternatives::doWork(const rapidjson::Value& result, const std::string & parentName, rapidjson::SizeType resultIndex, bool final) {
-	const rapidjson::Value & alternatives = getRequiredMember<ArrayLabel>(result, "alternatives", parentName.c_str());
+void DecoderAlternatives::doWork(const rapidjson::Value& result, const JsonPath & parentPath, rapidjson::SizeType resultIndex, bool final) {
+	const rapidjson::Value & alternatives = getRequiredMember<ArrayLabel>(result, "alternatives", parentPath);
 	alternativesSize = alternatives.Size();
-	std::string parentNameAlt = parentName + "#alternatives";
 	for (rapidjson::SizeType i = 0; i < alternativesSize; i++) {
-		std::stringstream ppname;
-		ppname << parentNameAlt << "[" << i << "]";
+		const JsonPath ppath(parentPath, "alternatives", i);
 
 		const rapidjson::Value & alternative = alternatives[i];
 		if (not alternative.IsObject()) {
-			throw DecoderException("alternative is not an Object. " + ppname.str() + " in json=" + *json);
+			throw DecoderException("alternative is not an Object. " + ppath.str() + " in json=" + *json);
 		}
 
 		// Decode confidence: Confidence is evaluated only if partial utterances are requested
 		if (configuration.sttOutputResultMode != WatsonSTTConfig::complete) {
 			if (resultIndex == 0) {
 				if (i == 0) {
-					const rapidjson::Value * confidenceVal = getOptionalMember<NumberLabel>(alternative, "confidence", ppname.str().c_str());
+					const rapidjson::Value * confidenceVal = getOptionalMember<NumberLabel>(alternative, "confidence", ppath);
 					if (confidenceVal) {
 						confidence = confidenceVal->GetDouble();
 					} else {
@@ -101,46 +108,45 @@ void DecoderAlternatives::doWork(const rapidjson::Value& result, const std::stri
 			}
 		}
 		// transcript
-		const rapidjson::Value & transcriptVal = getRequiredMember<StringLabel>(alternative, "transcript", ppname.str().c_str());
+		const rapidjson::Value & transcriptVal = getRequiredMember<StringLabel>(alternative, "transcript", ppath);
 		if (i == 0) { //utterance text
-			utteranceText.append(transcriptVal.GetString());
+			if (configuration.utteranceTextNeeded)
+				utteranceText.append(transcriptVal.GetString(), transcriptVal.GetStringLength());
 		} else {
 			// alternatives are collected only if not completeResults
 			// if we are requesting not completeResults it should not happen that there are more than one result
 			if ((configuration.sttOutputResultMode != WatsonSTTConfig::complete) && (resultIndex == 0)) {
-				utteranceAlternatives.pushBack(SPL::rstring(transcriptVal.GetString()));
+				utteranceAlternatives.pushBack(SPL::rstring(transcriptVal.GetString(), transcriptVal.GetStringLength()));
 			}
 		}
-		// timestamps
+		// timestamps are requested only if word times, utterance times or speakers are needed
 		if (i == 0) {
-			doWorkTimestamps(alternative, ppname.str().c_str(), resultIndex);
-			if (final) {
-				doWorkWordConfidence(alternative, ppname.str().c_str(), resultIndex);
+			if (configuration.wordTimestampNeeded)
+				doWorkTimestamps(alternative, ppath, resultIndex);
+			if (final && configuration.wordConfidenceNeeded) {
+				doWorkWordConfidence(alternative, ppath, resultIndex);
 			}
 		}
 	}
 
 }
 
-void DecoderAlternatives::doWorkTimestamps(const rapidjson::Value& alternative, const std::string & parentName, rapidjson::SizeType resultIndex) {
-	const rapidjson::Value * timestamps = getOptionalMember<ArrayLabel>(alternative, "timestamps", parentName.c_str());
+void DecoderAlternatives::doWorkTimestamps(const rapidjson::Value& alternative, const JsonPath & parentPath, rapidjson::SizeType resultIndex) {
+	const rapidjson::Value * timestamps = getOptionalMember<ArrayLabel>(alternative, "timestamps", parentPath);
 	if (timestamps) {
 		rapidjson::SizeType size = timestamps->Size();
-		std::string parentNameTim = parentName + "#timestamps";
 		for (rapidjson::SizeType i = 0; i < size; i++) {
-			std::stringstream ppname;
-			ppname << parentNameTim << "[" << i << "]";
-
 			const rapidjson::Value & timestamp = (*timestamps)[i];
 
 			if (timestamp.Size() != 3) {
-				throw DecoderException("timestamp size is not 3 " + ppname.str() + " json:" + *json);
+				throw DecoderException("timestamp size is not 3 " + JsonPath(parentPath, "timestamps", i).str() + " json:" + *json);
 			} else {
 				//std::cout << "ts index: " << i << timestamp[0].GetString() << "," << timestamp[1].GetDouble() << "," << timestamp[2].GetDouble() << std::endl;
 
 				// take words from timestamps because these are available also for non final utterances
 				// confidences are not available for non final utterances
-				utteranceWords.pushBack(SPL::rstring(timestamp[0].GetString()));
+				if (configuration.utteranceWordsNeeded)
+					utteranceWords.pushBack(SPL::rstring(timestamp[0].GetString(), timestamp[0].GetStringLength()));
 				utteranceWordsStartTimes.pushBack(timestamp[1].GetDouble());
 				utteranceWordsEndTimes.pushBack(timestamp[2].GetDouble());
 
@@ -153,19 +159,15 @@ void DecoderAlternatives::doWorkTimestamps(const rapidjson::Value& alternative,
 	}
 }
 
-void DecoderAlternatives::doWorkWordConfidence(const rapidjson::Value& alternative, const std::string & parentName, rapidjson::SizeType resultIndex) {
-	const rapidjson::Value * wordConfidences = getOptionalMember<ArrayLabel>(alternative, "word_confidence", parentName.c_str());
+void DecoderAlternatives::doWorkWordConfidence(const rapidjson::Value& alternative, const JsonPath & parentPath, rapidjson::SizeType resultIndex) {
+	const rapidjson::Value * wordConfidences = getOptionalMember<ArrayLabel>(alternative, "word_confidence", parentPath);
 	if (wordConfidences) {
 		rapidjson::SizeType size = wordConfidences->Size();
-		std::string parentNameConfd = parentName + "#word_confidence";
 		for (rapidjson::SizeType i = 0; i < size; i++) {
-			std::stringstream ppname;
-			ppname << parentNameConfd << "[" << i << "]";
-
 			const rapidjson::Value & wordConfidence = (*wordConfidences)[i];
 
 			if (wordConfidence.Size() != 2) {
-				throw DecoderException("wordConfidence size is not 2 " + ppname.str() + " in json:" + *json);
+				throw DecoderException("wordConfidence size is not 2 " + JsonPath(parentPath, "word_confidence", i).str() + " in json:" + *json);
 			} else {
 				//utteranceWords.pushBack(SPL::rstring(wordConfidence[0].GetString()));
 				utteranceWordsConfidences.pushBack(wordConfidence[1].GetDouble());
@@ -15,6 +15,9 @@
 #include <string>
 #include <stdexcept>
 #include <sstream>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 #include "WatsonSTTConfig.hpp"
 
@@ -41,25 +44,104 @@ template<>               bool isType<NumberLabel> (const rapidjson::Value& membe
 template<>               bool isType<StringLabel> (const rapidjson::Value& member) { return member.IsString(); }
 template<>               bool isType<ArrayLabel>  (const rapidjson::Value& member) { return member.IsArray(); }
 
+/*
+ * The path of a json value used in error messages e.g. universe#results[0]#alternatives[1]
+ * A path is a chain of stack objects; the path string is built only when an error is reported
+ */
+class JsonPath {
+public:
+	// the root of a path
+	explicit JsonPath(const char * name_) :
+		parent(nullptr), name(name_), key(nullptr), index(0), hasIndex(false) {}
+	// member name in parent
+	JsonPath(const JsonPath & parent_, const char * name_) :
+		parent(&parent_), name(name_), key(nullptr), index(0), hasIndex(false) {}
+	// array element of member name in parent
+	JsonPath(const JsonPath & parent_, const char * name_, rapidjson::SizeType index_) :
+		parent(&parent_), name(name_), key(nullptr), index(index_), hasIndex(true) {}
+	// member key of the object member name in parent
+	JsonPath(const JsonPath & parent_, const char * name_, const char * key_) :
+		parent(&parent_), name(name_), key(key_), index(0), hasIndex(false) {}
+	// array element of the array parent
+	JsonPath(const JsonPath & parent_, rapidjson::SizeType index_) :
+		parent(&parent_), name(nullptr), key(nullptr), index(index_), hasIndex(true) {}
+
+	std::string str() const {
+		std::string res;
+		if (parent)
+			res = parent->str();
+		if (name) {
+			if (parent)
+				res.append("#");
+			res.append(name);
+		}
+		if (key)
+			res.append("[").append(key).append("]");
+		if (hasIndex)
+			res.append("[").append(std::to_string(index)).append("]");
+		return res;
+	}
+
+private:
+	const JsonPath * const parent;
+	const char * const name;
+	const char * const key;
+	const rapidjson::SizeType index;
+	const bool hasIndex;
+};
+
 class DecoderCommons {
 protected:
+	// The document type: the values and the parse stack are allocated from memory pools owned by the decoder
+	typedef rapidjson::MemoryPoolAllocator<> PoolAllocator;
+	typedef rapidjson::GenericDocument<rapidjson::UTF8<>, PoolAllocator, PoolAllocator> DocumentType;
+	// The size of the first chunk of the value pool; this chunk is re-used for every document
+	static constexpr size_t valueBufferSize = 16384;
+
 	// Input string pointer: points during work to input string
 	const std::string * json;
+	// The first chunk of the value pool and the value pool
+	// The pool is cleared before a document is parsed; only the documents which do not fit into the
+	// first chunk allocate memory
+	// The buffer is an array of uint64_t to get the 8 byte alignment of the pool chunks; an over-aligned
+	// member would propagate to the virtual base and break the layout of the derived decoders
+	uint64_t valueBuffer[valueBufferSize / sizeof(uint64_t)];
+	PoolAllocator valueAllocator;
+	// The copy of the input which is parsed in situ; the strings of the document point into this buffer
+	// The input is kept unchanged for the error messages
+	std::vector<char> insituBuffer;
 	// Document after parsing
-	rapidjson::Document jsonDoc;
+	DocumentType jsonDoc;
 	// Configuration values
 	const WatsonSTTConfig & configuration;
 	// static log aspect
 	static const char* const WATSON_DECODER;
+	// the root path of all json values
+	static const JsonPath universe;
 
 	// ctor
 	DecoderCommons(const WatsonSTTConfig & config) :
-		json(nullptr), jsonDoc(), configuration(config) {
+		json(nullptr), valueBuffer(), valueAllocator(valueBuffer, valueBufferSize), insituBuffer(),
+		jsonDoc(&valueAllocator), configuration(config) {
 	}
+	DecoderCommons(const DecoderCommons &) = delete;
+	DecoderCommons & operator=(const DecoderCommons &) = delete;
+
 	// start decoding initialize json and jsonDoc
 	void doWorkStart(std::string const & inp) {
 		json = & inp;
-		jsonDoc.Parse(json->c_str());
+		// release the values of the previous document before the pool is cleared
+		jsonDoc.SetNull();
+		valueAllocator.Clear();
+		insituBuffer.assign(inp.c_str(), inp.c_str() + inp.size() + 1);
+		jsonDoc.ParseInsitu(insituBuffer.data());
+		if (jsonDoc.HasParseError()) {
+			throw DecoderException("json parse error " + std::to_string(jsonDoc.GetParseError()) +
+					" at offset " + std::to_string(jsonDoc.GetErrorOffset()) + " json=" + *json);
+		}
+		if ( ! jsonDoc.IsObject()) {
+			throw DecoderException("json is not an Object json=" + *json);
+		}
 	}
 	// stop working
 	void doWorkEnd() noexcept {
@@ -67,16 +149,15 @@ protected:
 	}
 	// get a required member
 	template<char* JSONTYPE>
-	const rapidjson::Value& getRequiredMember(const rapidjson::Value& value, const char* memberName, const char* parentName) const {
-		if ( ! value.HasMember(memberName)) {
-			std::stringstream ss("member "); ss << memberName << " is required in " << parentName << " json=" << *json;
-			throw DecoderException(ss.str());
+	const rapidjson::Value& getRequiredMember(const rapidjson::Value& value, const char* memberName, const JsonPath & parent) const {
+		rapidjson::Value::ConstMemberIterator it = value.FindMember(memberName);
+		if (it == value.MemberEnd()) {
+			throw DecoderException(std::string("member ") + memberName + " is required in " + parent.str() + " json=" + *json);
 		}
 		SPLAPPTRC(L_TRACE, memberName << " found", WATSON_DECODER);
-		const rapidjson::Value& member = value[memberName];
+		const rapidjson::Value& member = it->value;
 		if ( ! isType<JSONTYPE>(member)) {
-			std::stringstream ss; ss << memberName << " is not a " << JSONTYPE << " in " << parentName << " json=" << *json;
-			throw DecoderException(ss.str());
+			throw DecoderException(std::string(memberName) + " is not a " + JSONTYPE + " in " + parent.str() + " json=" + *json);
 		}
 		SPLAPPTRC(L_TRACE, memberName << " is " << JSONTYPE, WATSON_DECODER);
 		return member;
@@ -84,14 +165,14 @@ protected:
 
 	// get an option member; return nullptr if not there
 	template<char* JSONTYPE>
-	const rapidjson::Value* getOptionalMember(const rapidjson::Value& value, const char* memberName, const char* parentName) const {
-		if ( ! value.HasMember(memberName))
+	const rapidjson::Value* getOptionalMember(const rapidjson::Value& value, const char* memberName, const JsonPath & parent) const {
+		rapidjson::Value::ConstMemberIterator it = value.FindMember(memberName);
+		if (it == value.MemberEnd())
 			return nullptr;
 		SPLAPPTRC(L_TRACE, memberName << " found", WATSON_DECODER);
-		const rapidjson::Value& member = value[memberName];
+		const rapidjson::Value& member = it->value;
 		if ( ! isType<JSONTYPE>(member)) {
-			std::stringstream ss; ss << memberName << " is not a " << JSONTYPE << " in " << parentName << " json=" << *json;
-			throw DecoderException(ss.str());
+			throw DecoderException(std::string(memberName) + " is not a " + JSONTYPE + " in " + parent.str() + " json=" + *json);
 		}
 		SPLAPPTRC(L_TRACE, memberName << " is " << JSONTYPE, WATSON_DECODER);
 		return &member;
@@ -99,6 +180,7 @@ protected:
 };
 
 const char* const DecoderCommons::WATSON_DECODER = "WatsonDecoder";
+const JsonPath DecoderCommons::universe("universe");
 
 }}}}
 #endif /* COM_IBM_STREAMS_STTGATEWAY_DECODER_COMMONS_H_ */
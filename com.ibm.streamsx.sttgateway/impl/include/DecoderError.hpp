@@ -24,7 +24,7 @@ protected:
 	}
 
 	void doWork() {
-		errorValue = getOptionalMember<StringLabel>(jsonDoc, "error", "universe");
+		errorValue = getOptionalMember<StringLabel>(jsonDoc, "error", universe);
 	}
 };
 
@@ -27,8 +27,8 @@ protected:
 		finals_.clear();
 	}
 
-	void doWork(const rapidjson::Value & result, const std::string & parentName) {
-		const rapidjson::Value & final = getRequiredMember<BooleanLabel>(result, "final", parentName.c_str());
+	void doWork(const rapidjson::Value & result, const JsonPath & parentPath) {
+		const rapidjson::Value & final = getRequiredMember<BooleanLabel>(result, "final", parentPath);
 		finals_.push_back(final.GetBool());
 	}
 };
@@ -19,60 +19,95 @@ class DecoderKeywordsResult : public virtual DecoderCommons {
 public:
 	// do not use SPL list and map because the KeywordEmergence has no serialization implementation
 	struct KeywordEmergenceStruct { double start_time; double end_time; double confidence; };
-	typedef std::unordered_map<std::string, std::vector<KeywordEmergenceStruct> > ResultMapType;
+	typedef std::vector<KeywordEmergenceStruct> EmergenceListType;
 private:
-	ResultMapType kwmaplist;
+	// the keywords to be spotted and the hash index of the keywords into this list
+	const std::vector<SPL::rstring> keywords;
+	std::unordered_map<std::string, size_t> keywordIndex;
+	// the emergences of each keyword; the lists are cleared but not released
+	std::vector<EmergenceListType> emergences;
+	// the indexes of the keywords with emergences in the order of the first emergence
+	std::vector<size_t> hits;
+	// the lookup key of a keyword_result member; keeps its capacity
+	std::string lookupKey;
 
 public:
-	bool                  hasResult() const noexcept                  { return kwmaplist.size() > 0; }
-	const ResultMapType & getKeywordsSpottingResults() const noexcept { return kwmaplist; }
+	bool                        hasResult() const noexcept               { return hits.size() > 0; }
+	const std::vector<size_t> & getKeywordHits() const noexcept          { return hits; }
+	const SPL::rstring &        getKeyword(size_t idx) const             { return keywords[idx]; }
+	const EmergenceListType &   getKeywordEmergences(size_t idx) const   { return emergences[idx]; }
+	// Find the index of a keyword to be spotted; returns false if the keyword is not in the list
+	bool findKeyword(const std::string & keyword, size_t & idx) const {
+		const auto it = keywordIndex.find(keyword);
+		if (it == keywordIndex.end())
+			return false;
+		idx = it->second;
+		return true;
+	}
 
 protected:
 	DecoderKeywordsResult(const WatsonSTTConfig & config) :
-		DecoderCommons(config), kwmaplist() {
+		DecoderCommons(config),
+		keywords(config.keywordsToBeSpotted.begin(), config.keywordsToBeSpotted.end()),
+		keywordIndex(), emergences(keywords.size()), hits(), lookupKey() {
+		keywordIndex.reserve(keywords.size());
+		for (size_t idx = 0; idx < keywords.size(); idx++) {
+			// a duplicate keyword is mapped to the first entry
+			keywordIndex.emplace(keywords[idx], idx);
+		}
 	}
 
+	// the cost of reset depends on the number of hits of the last result
 	void reset() {
-		kwmaplist.clear();
+		for (const size_t idx : hits)
+			emergences[idx].clear();
+		hits.clear();
 	}
 
-	void doWork(const rapidjson::Value& result, const std::string & parentName, rapidjson::SizeType resultIndex);
+	void doWork(const rapidjson::Value& result, const JsonPath & parentPath, rapidjson::SizeType resultIndex);
 };
 
 
-void DecoderKeywordsResult::doWork(const rapidjson::Value& result, const std::string & parentName, rapidjson::SizeType resultIndex) {
-	const rapidjson::Value * keywords_result_ = getOptionalMember<ObjectLabel>(result, "keywords_result", parentName.c_str());
+void DecoderKeywordsResult::doWork(const rapidjson::Value& result, const JsonPath & parentPath, rapidjson::SizeType resultIndex) {
+	const rapidjson::Value * keywords_result_ = getOptionalMember<ObjectLabel>(result, "keywords_result", parentPath);
 	if (not keywords_result_) {
 		return;
 	}
 
-	std::string parentNameKwres = parentName + "#keywords_result";
-	for (auto kw : configuration.keywordsToBeSpotted) {
-		const rapidjson::Value * keyword_ = getOptionalMember<ArrayLabel>(*keywords_result_, kw.c_str(), parentNameKwres.c_str());
-		if (keyword_) {
-			std::stringstream ppname;
-			ppname << parentNameKwres << "[" << kw << "]";
-			if (not keyword_->IsArray()) {
-				throw DecoderException("Keyword " + kw.string() + " is not an array in " + ppname.str());
-			}
+	// iterate over the spotted keywords only; the cost does not depend on the size of keywordsToBeSpotted
+	for (rapidjson::Value::ConstMemberIterator kwit = keywords_result_->MemberBegin(); kwit != keywords_result_->MemberEnd(); ++kwit) {
+		lookupKey.assign(kwit->name.GetString(), kwit->name.GetStringLength());
+		size_t idx = 0;
+		if (not findKeyword(lookupKey, idx)) {
+			SPLAPPTRC(L_DEBUG, "Keyword " << lookupKey << " is not in keywordsToBeSpotted", WATSON_DECODER);
+			continue;
+		}
+		const JsonPath ppath(parentPath, "keywords_result", keywords[idx].c_str());
+		const rapidjson::Value & keyword_ = kwit->value;
+		if (not keyword_.IsArray()) {
+			throw DecoderException("Keyword " + keywords[idx].string() + " is not an array in " + ppath.str());
+		}
 
-			std::vector<KeywordEmergenceStruct> innerList;
-			rapidjson::SizeType sz = keyword_->Size();
-			for (rapidjson::SizeType i = 0; i < sz; i++) {
-				std::stringstream pppname;
-				pppname << parentName << "[" << i << "]";
-				const rapidjson::Value & match = (*keyword_)[i];
-				const rapidjson::Value & normalized_text = getRequiredMember<StringLabel>(match, "normalized_text", pppname.str().c_str());
-				const rapidjson::Value & start_time      = getRequiredMember<NumberLabel>(match, "start_time", pppname.str().c_str());
-				const rapidjson::Value & end_time        = getRequiredMember<NumberLabel>(match, "end_time", pppname.str().c_str());
-				const rapidjson::Value & confidence      = getRequiredMember<NumberLabel>(match, "confidence", pppname.str().c_str());
-				SPL::map<SPL::rstring, SPL::float64> innerMap;
-				const double st = start_time.GetDouble();
-				const double et = end_time.GetDouble();
-				const double cf = confidence.GetDouble();
-				innerList.push_back(KeywordEmergenceStruct{st, et, cf});
-			}
-			kwmaplist.insert(ResultMapType::value_type(kw, innerList));
+		rapidjson::SizeType sz = keyword_.Size();
+		if (sz == 0)
+			continue;
+		// the emergences of all final results are concatenated
+		EmergenceListType & innerList = emergences[idx];
+		if (innerList.empty())
+			hits.push_back(idx);
+		innerList.reserve(innerList.size() + sz);
+		for (rapidjson::SizeType i = 0; i < sz; i++) {
+			const JsonPath pppath(ppath, i);
+			const rapidjson::Value & match = keyword_[i];
+			// the normalized text is validated but not used
+			getRequiredMember<StringLabel>(match, "normalized_text", pppath);
+			const rapidjson::Value & start_time      = getRequiredMember<NumberLabel>(match, "start_time", pppath);
+			const rapidjson::Value & end_time        = getRequiredMember<NumberLabel>(match, "end_time", pppath);
+			const rapidjson::Value & confidence      = getRequiredMember<NumberLabel>(match, "confidence", pppath);
+			const double st = start_time.GetDouble();
+			const double et = end_time.GetDouble();
+			const double cf = confidence.GetDouble();
+			innerList.push_back(KeywordEmergenceStruct{st, et, cf});
 		}
 	}
 }
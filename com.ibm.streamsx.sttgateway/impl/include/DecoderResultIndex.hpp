@@ -32,7 +32,7 @@ protected:
 	}
 
 	void doWork() {
-		resultIndexValue = getOptionalMember<NumberLabel>(jsonDoc, "result_index", "universe");
+		resultIndexValue = getOptionalMember<NumberLabel>(jsonDoc, "result_index", universe);
 	}
 };
 
@@ -48,7 +48,7 @@ protected:
 	// DecoderKeywordsResult -> decoding for final results only and concatenate all results
 	// DecoderWordAlternatives -> decoding for final results only and concatenate all results
 	void doWork() {
-		const rapidjson::Value * results = getOptionalMember<ArrayLabel>(jsonDoc, "results", "universe");
+		const rapidjson::Value * results = getOptionalMember<ArrayLabel>(jsonDoc, "results", universe);
 		if (results) {
 			resultsSize = results->Size();
 			if (configuration.sttOutputResultMode != WatsonSTTConfig::complete) {
@@ -57,21 +57,22 @@ protected:
 				}
 			}
 			for (rapidjson::SizeType i = 0; i < resultsSize; i++) {
-				std::stringstream ppname;
-				ppname << "results[" << i << "]";
+				const JsonPath ppath(universe, "results", i);
 				const rapidjson::Value & result = (*results)[i];
 				if (not result.IsObject()) {
-					std::stringstream ss; ss << "Result is not an Object. " << ppname << " in json=" << *json;
-					throw DecoderException(ss.str());
+					throw DecoderException("Result is not an Object. " + ppath.str() + " in json=" + *json);
 				}
-				DecoderFinal::doWork(result, ppname.str().c_str());
+				DecoderFinal::doWork(result, ppath);
 				bool final = DecoderFinal::getResult(i);
 				if (final || (configuration.sttOutputResultMode == WatsonSTTConfig::partial)) {
-					DecoderAlternatives::doWork(result, ppname.str().c_str(), i, final);
+					DecoderAlternatives::doWork(result, ppath, i, final);
 				}
 				if (final) {
-					DecoderWordAlternatives::doWork(result, ppname.str().c_str(), i);
-					DecoderKeywordsResult::doWork(result, ppname.str().c_str(), i);
+					// skip the results which are not consumed by an output attribute
+					if (configuration.wordAlternativesThreshold > 0.0)
+						DecoderWordAlternatives::doWork(result, ppath, i);
+					if (configuration.keywordsSpottingResultsNeeded)
+						DecoderKeywordsResult::doWork(result, ppath, i);
 				}
 			}
 		} else {
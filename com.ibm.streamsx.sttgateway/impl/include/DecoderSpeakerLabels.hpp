@@ -38,20 +38,18 @@ protected:
 	}
 
 	void doWork() {
-		const rapidjson::Value * speakerLabels = getOptionalMember<ArrayLabel>(jsonDoc, "speaker_labels", "universe");
+		const rapidjson::Value * speakerLabels = getOptionalMember<ArrayLabel>(jsonDoc, "speaker_labels", universe);
 		if (speakerLabels) {
 			size_ = speakerLabels->Size();
-			std::string parentName("universe#speaker_labels");
 			for (rapidjson::SizeType i = 0; i < size_; i++) {
-				std::stringstream ppname;
-				ppname << parentName << "[" << i << "]";
+				const JsonPath ppath(universe, "speaker_labels", i);
 				rapidjson::Value const & speaker = (*speakerLabels)[i];
 				if ( ! speaker.IsObject()) {
-					throw DecoderException("Speaker is not an Object. Parent: " + ppname.str() + " in json=" + *json);
+					throw DecoderException("Speaker is not an Object. Parent: " + ppath.str() + " in json=" + *json);
 				}
-				const rapidjson::Value & from = getRequiredMember<NumberLabel>(speaker, "from", ppname.str().c_str());
-				const rapidjson::Value & spk = getRequiredMember<IntegerLabel>(speaker, "speaker", ppname.str().c_str());
-				const rapidjson::Value & conf = getRequiredMember<NumberLabel>(speaker, "confidence", ppname.str().c_str());
+				const rapidjson::Value & from = getRequiredMember<NumberLabel>(speaker, "from", ppath);
+				const rapidjson::Value & spk = getRequiredMember<IntegerLabel>(speaker, "speaker", ppath);
+				const rapidjson::Value & conf = getRequiredMember<NumberLabel>(speaker, "confidence", ppath);
 				from_.pushBack(SPL::float64(from.GetDouble()));
 				speaker_.pushBack(SPL::int32(spk.GetInt()));
 				confidence_.pushBack(SPL::float64(conf.GetDouble()));
@@ -26,7 +26,7 @@ protected:
 	}
 
 	void doWork() {
-		stateValue = getOptionalMember<StringLabel>(jsonDoc, "state", "universe");
+		stateValue = getOptionalMember<StringLabel>(jsonDoc, "state", universe);
 		if (stateValue) {
 			std::string statevar = stateValue->GetString();
 			isListening_ = statevar == "listening";
@@ -7,6 +7,7 @@
 #define COM_IBM_STREAMS_STTGATEWAY_DECODER_WORD_ALTERNATIVES_H_
 
 #include "DecoderCommons.hpp"
+#include <utility>
 #include <vector>
 
 namespace com { namespace ibm { namespace streams { namespace sttgateway {
@@ -26,6 +27,12 @@ public:
 	const SPL::list<SPL::list<SPL::rstring> > & getWordAlternatives() const noexcept            { return wordAlternatives; }
 	const SPL::list<SPL::list<SPL::float64> > & getWordAlternativesConfidences() const noexcept { return wordConfidences; }
 
+	// Hand off the results; the content is unspecified until the next doWork
+	SPL::list<SPL::float64> &&                  releaseWordAlternativesStartTimes() noexcept    { return std::move(startTimes); }
+	SPL::list<SPL::float64> &&                  releaseWordAlternativesEndTimes() noexcept      { return std::move(endTimes); }
+	SPL::list<SPL::list<SPL::rstring> > &&      releaseWordAlternatives() noexcept              { return std::move(wordAlternatives); }
+	SPL::list<SPL::list<SPL::float64> > &&      releaseWordAlternativesConfidences() noexcept   { return std::move(wordConfidences); }
+
 protected:
 	DecoderWordAlternatives(const WatsonSTTConfig & config) :
 		DecoderCommons(config),
@@ -40,46 +47,44 @@ protected:
 		wordConfidences.clear();
 	}
 
-	void doWork(const rapidjson::Value& result, const std::string & parentName, rapidjson::SizeType resultIndex);
+	void doWork(const rapidjson::Value& result, const JsonPath & parentPath, rapidjson::SizeType resultIndex);
 };
 
-void DecoderWordAlternatives::doWork(const rapidjson::Value& result, const std::string & parentName, rapidjson::SizeType resultIndex) {
-	const rapidjson::Value * wordAlternatives_ = getOptionalMember<ArrayLabel>(result, "word_alternatives", parentName.c_str());
+void DecoderWordAlternatives::doWork(const rapidjson::Value& result, const JsonPath & parentPath, rapidjson::SizeType resultIndex) {
+	const rapidjson::Value * wordAlternatives_ = getOptionalMember<ArrayLabel>(result, "word_alternatives", parentPath);
 	if (not wordAlternatives_) {
 		alternativesSize = 0;
 		return;
 	}
 	alternativesSize = wordAlternatives_->Size();
 	for (rapidjson::SizeType i = 0; i < alternativesSize; i++) {
-		std::stringstream ppname;
-		ppname << parentName << "#word_alternatives[" << i << "]";
+		const JsonPath ppath(parentPath, "word_alternatives", i);
 
 		const rapidjson::Value & wordAlternative_ = (*wordAlternatives_)[i];
 		if (not wordAlternative_.IsObject()) {
-			throw DecoderException("wordAlternative is not an Object. " + ppname.str() + " in json=" + *json);
+			throw DecoderException("wordAlternative is not an Object. " + ppath.str() + " in json=" + *json);
 		}
 
-		const rapidjson::Value & startTime_ = getRequiredMember<NumberLabel>(wordAlternative_, "start_time", ppname.str().c_str());
+		const rapidjson::Value & startTime_ = getRequiredMember<NumberLabel>(wordAlternative_, "start_time", ppath);
 		startTimes.pushBack(startTime_.GetDouble());
 
-		const rapidjson::Value & endTime_ = getRequiredMember<NumberLabel>(wordAlternative_, "end_time", ppname.str().c_str());
+		const rapidjson::Value & endTime_ = getRequiredMember<NumberLabel>(wordAlternative_, "end_time", ppath);
 		endTimes.push_back(endTime_.GetDouble());
 
-		const rapidjson::Value & alternatives_ = getRequiredMember<ArrayLabel>(wordAlternative_, "alternatives", ppname.str().c_str());
+		const rapidjson::Value & alternatives_ = getRequiredMember<ArrayLabel>(wordAlternative_, "alternatives", ppath);
 		SPL::list<SPL::rstring> words_;
 		SPL::list<SPL::float64> confidences_;
 		rapidjson::SizeType wordsSize_ = alternatives_.Size();
 		for (rapidjson::SizeType j = 0; j < wordsSize_; j++) {
-			std::stringstream pppname;
-			ppname << parentName << "[" << j << "]";
+			const JsonPath pppath(ppath, "alternatives", j);
 
 			const rapidjson::Value & alternative_ = alternatives_[j];
 			if (not alternative_.IsObject()) {
-				throw DecoderException("alternative is not an Object. " + pppname.str() + " in json=" + *json);
+				throw DecoderException("alternative is not an Object. " + pppath.str() + " in json=" + *json);
 			}
-			const rapidjson::Value & word_ = getRequiredMember<StringLabel>(alternative_, "word", pppname.str().c_str());
+			const rapidjson::Value & word_ = getRequiredMember<StringLabel>(alternative_, "word", pppath);
 			words_.push_back(SPL::rstring(word_.GetString()));
-			const rapidjson::Value & confidence_ = getRequiredMember<NumberLabel>(alternative_, "confidence", pppname.str().c_str());
+			const rapidjson::Value & confidence_ = getRequiredMember<NumberLabel>(alternative_, "confidence", pppath);
 			confidences_.push_back(confidence_.GetDouble());
 		}
 		wordAlternatives.pushBack(words_);
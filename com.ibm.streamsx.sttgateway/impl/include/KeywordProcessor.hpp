@@ -0,0 +1,98 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_KEYWORD_PROCESSOR_H_
+#define COM_IBM_STREAMS_STTGATEWAY_KEYWORD_PROCESSOR_H_
+
+#include <SPL/Runtime/Type/SPLType.h>
+
+#include "DecoderKeywordResults.hpp"
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+/* data struct and function to get the keyword result */
+class KeywordProcessor {
+	// nullptr if there is no keyword result
+	const DecoderKeywordsResult * const keywordResults;
+
+public:
+	KeywordProcessor(const DecoderKeywordsResult & keywordResults_);
+	KeywordProcessor();
+	KeywordProcessor(const KeywordProcessor&) = delete;
+	KeywordProcessor(KeywordProcessor&&) = delete;
+	KeywordProcessor& operator=(const KeywordProcessor&) = delete;
+	KeywordProcessor& operator=(const KeywordProcessor&&) = delete;
+	// Update the destination map with the keyword results
+	// The entries and lists of the destination are re-used; the cost depends on the number of hits
+	template<typename T>
+	void getKeywordsSpottingResults(SPL::map<SPL::rstring, SPL::list<T> > & destination) const;
+
+private:
+	// Erase the entries without emergences from the destination
+	template<typename T>
+	void eraseMissingKeywords(SPL::map<SPL::rstring, SPL::list<T> > & destination) const;
+};
+
+KeywordProcessor::KeywordProcessor(const DecoderKeywordsResult & keywordResults_) :
+	keywordResults(&keywordResults_) {
+}
+
+KeywordProcessor::KeywordProcessor() :
+	keywordResults(nullptr) {
+}
+
+template<typename T>
+void KeywordProcessor::eraseMissingKeywords(SPL::map<SPL::rstring, SPL::list<T> > & destination) const {
+	auto it = destination.begin();
+	while (it != destination.end()) {
+		size_t idx = 0;
+		if (keywordResults->findKeyword(it->first, idx) && ! keywordResults->getKeywordEmergences(idx).empty())
+			++it;
+		else
+			it = destination.erase(it);
+	}
+}
+
+template<typename T>
+void KeywordProcessor::getKeywordsSpottingResults(SPL::map<SPL::rstring, SPL::list<T> > & destination) const {
+	if ( ! keywordResults || ! keywordResults->hasResult()) {
+		destination.clear();
+		return;
+	}
+	eraseMissingKeywords(destination);
+	for (const size_t idx : keywordResults->getKeywordHits()) {
+		const auto & emergences = keywordResults->getKeywordEmergences(idx);
+		SPL::list<T> & i = destination[keywordResults->getKeyword(idx)];
+		i.resize(emergences.size());
+		for (size_t j = 0; j < emergences.size(); j++) {
+			T & t = i[j];
+			t.set_startTime(emergences[j].start_time);
+			t.set_endTime(emergences[j].end_time);
+			t.set_confidence(emergences[j].confidence);
+		}
+	}
+}
+
+template<>
+void KeywordProcessor::getKeywordsSpottingResults<SPL::map<SPL::rstring, SPL::float64> >(SPL::map<SPL::rstring, SPL::list<SPL::map<SPL::rstring, SPL::float64> > > & destination) const {
+	if ( ! keywordResults || ! keywordResults->hasResult()) {
+		destination.clear();
+		return;
+	}
+	eraseMissingKeywords(destination);
+	for (const size_t idx : keywordResults->getKeywordHits()) {
+		const auto & emergences = keywordResults->getKeywordEmergences(idx);
+		SPL::list<SPL::map<SPL::rstring, SPL::float64> > & i = destination[keywordResults->getKeyword(idx)];
+		i.resize(emergences.size());
+		for (size_t j = 0; j < emergences.size(); j++) {
+			SPL::map<SPL::rstring, SPL::float64> & t = i[j];
+			t["start_time"] = emergences[j].start_time;
+			t["set_end_time"] = emergences[j].end_time;
+			t["confidence"] = emergences[j].confidence;
+		}
+	}
+}
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_KEYWORD_PROCESSOR_H_ */
@@ -0,0 +1,132 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_LATENCYHISTOGRAM_HPP_
+#define COM_IBM_STREAMS_STTGATEWAY_LATENCYHISTOGRAM_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+/*
+ * A histogram of durations in microseconds with power of 2 bucket bounds
+ * The bucket i counts the values up to 2^i microseconds; the last bucket counts all larger values.
+ * A histogram is recorded by one thread only. It can be read by any thread at any time.
+ * The counters are relaxed atomics which are updated without a lock or an atomic read-modify-write.
+ */
+class LatencyHistogram {
+public:
+	// The bucket bounds reach from 1 microsecond to 2^24 microseconds (about 16.8 seconds)
+	static const size_t numBuckets = 26;
+
+	LatencyHistogram() : count(0), sum(0) {
+		for (size_t i = 0; i < numBuckets; ++i)
+			buckets[i] = 0;
+	}
+	LatencyHistogram(const LatencyHistogram&) = delete;
+	LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+	// Get the upper bound in microseconds of bucket i < numBuckets - 1
+	static uint64_t upperBound(size_t i) { return uint64_t(1) << i; }
+
+	// Record one value; must be called from the owning thread only
+	void record(uint64_t micros) {
+		size_t i = 0;
+		if (micros > 1) {
+			i = 64 - __builtin_clzll(micros - 1);
+			if (i > numBuckets - 1)
+				i = numBuckets - 1;
+		}
+		increment(buckets[i], 1);
+		increment(count, 1);
+		increment(sum, micros);
+	}
+
+	// Record the time since start
+	void recordSince(std::chrono::steady_clock::time_point start) {
+		record(std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - start).count());
+	}
+
+	/*
+	 * The sum of the histograms of several threads
+	 */
+	struct Snapshot {
+		uint64_t buckets[numBuckets];
+		uint64_t count;
+		uint64_t sum;
+
+		Snapshot() : count(0), sum(0) {
+			for (size_t i = 0; i < numBuckets; ++i)
+				buckets[i] = 0;
+		}
+
+		void add(const LatencyHistogram & h) {
+			for (size_t i = 0; i < numBuckets; ++i)
+				buckets[i] += h.buckets[i].load(std::memory_order_relaxed);
+			count += h.count.load(std::memory_order_relaxed);
+			sum += h.sum.load(std::memory_order_relaxed);
+		}
+
+		// Write the histogram in the Prometheus text exposition format
+		void write(std::ostream & os, const std::string & name, const std::string & help) const {
+			os << "# HELP " << name << " " << help << "\n";
+			os << "# TYPE " << name << " histogram\n";
+			uint64_t cumulative = 0;
+			for (size_t i = 0; i < numBuckets - 1; ++i) {
+				cumulative += buckets[i];
+				os << name << "_bucket{le=\"" << upperBound(i) << "\"} " << cumulative << "\n";
+			}
+			// the buckets, the count and the sum are read without a lock and may be updated concurrently;
+			// the count is taken from the buckets read in this pass so that the +Inf bucket equals the count
+			// and no bucket exceeds it
+			cumulative += buckets[numBuckets - 1];
+			os << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+			os << name << "_sum " << sum << "\n";
+			os << name << "_count " << cumulative << "\n";
+		}
+	};
+
+private:
+	static void increment(std::atomic<uint64_t> & counter, uint64_t value) {
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+	std::atomic<uint64_t> buckets[numBuckets];
+	std::atomic<uint64_t> count;
+	std::atomic<uint64_t> sum;
+};
+
+/*
+ * Records the life time of the scope into a histogram
+ * Nothing is recorded if the histogram is null. The start time is taken in any case.
+ */
+class ScopedLatency {
+public:
+	explicit ScopedLatency(LatencyHistogram * histogram_) :
+		histogram(histogram_),
+		start(std::chrono::steady_clock::now()) {}
+	~ScopedLatency() {
+		if (histogram)
+			histogram->recordSince(start);
+	}
+	ScopedLatency(const ScopedLatency&) = delete;
+	ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+	// Get the time when the scope was entered
+	std::chrono::steady_clock::time_point getStart() const { return start; }
+
+private:
+	LatencyHistogram * const histogram;
+	const std::chrono::steady_clock::time_point start;
+};
+
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_LATENCYHISTOGRAM_HPP_ */
@@ -0,0 +1,99 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_MAPPEDAUDIOFILE_HPP_
+#define COM_IBM_STREAMS_STTGATEWAY_MAPPEDAUDIOFILE_HPP_
+
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+/*
+ * Read only memory mapping of an audio file
+ * The file content is not copied into the heap. The pages are loaded on demand when the
+ * audio is sent and the pages already sent can be released with release.
+ * Thus the memory consumption does not depend on the file size.
+ */
+class MappedAudioFile {
+public:
+	MappedAudioFile() : data(nullptr), size(0), released(0) {}
+	~MappedAudioFile() { unmap(); }
+	MappedAudioFile(MappedAudioFile const &) = delete;
+	MappedAudioFile & operator=(MappedAudioFile const &) = delete;
+
+	// Map the file fileName
+	// Returns false and sets errorText if the file can not be opened or mapped
+	// An empty file is not mapped; data is null and size is 0 in this case
+	bool map(std::string const & fileName, std::string & errorText) {
+		unmap();
+		int fd = ::open(fileName.c_str(), O_RDONLY);
+		if (fd < 0) {
+			errorText = std::strerror(errno);
+			return false;
+		}
+		struct stat fileStat;
+		if (::fstat(fd, &fileStat) != 0) {
+			errorText = std::strerror(errno);
+			::close(fd);
+			return false;
+		}
+		if (fileStat.st_size > 0) {
+			void * addr = ::mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (addr == MAP_FAILED) {
+				errorText = std::strerror(errno);
+				::close(fd);
+				return false;
+			}
+			// the file is sent from start to end: enable aggressive read ahead
+			::madvise(addr, fileStat.st_size, MADV_SEQUENTIAL);
+			data = static_cast<unsigned char const *>(addr);
+			size = static_cast<uint64_t>(fileStat.st_size);
+		}
+		// the mapping is still valid after the close of the file descriptor
+		::close(fd);
+		return true;
+	}
+
+	// Release the pages of the first bytes of the mapping; the bytes must not be accessed any longer
+	// Only full pages are released
+	void release(uint64_t bytes) {
+		if ((data == nullptr) || (bytes > size))
+			return;
+		static const uint64_t pageSize = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+		uint64_t end = bytes - bytes % pageSize;
+		if (end > released) {
+			::madvise(const_cast<unsigned char *>(data) + released, end - released, MADV_DONTNEED);
+			released = end;
+		}
+	}
+
+	unsigned char const * getData() const { return data; }
+	uint64_t getSize() const { return size; }
+
+private:
+	void unmap() {
+		if (data != nullptr)
+			::munmap(const_cast<unsigned char *>(data), size);
+		data = nullptr;
+		size = 0;
+		released = 0;
+	}
+
+	unsigned char const * data;
+	uint64_t size;
+	// the number of bytes at the start of the mapping, which are already released
+	uint64_t released;
+};
+
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_MAPPEDAUDIOFILE_HPP_ */
@@ -0,0 +1,126 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_PHRASEDICTIONARY_HPP_
+#define COM_IBM_STREAMS_STTGATEWAY_PHRASEDICTIONARY_HPP_
+
+#include <SPL/Runtime/Type/SPLType.h>
+#include <SPL/Runtime/Function/SPLFunctions.h>
+
+#include <sys/stat.h>
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "PhraseMatcher.hpp"
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+/*
+ * The sources of the phrase dictionary: a file and / or an application configuration
+ * The file has one phrase per line; empty lines and lines starting with # are ignored.
+ * Each property value of the application configuration is one phrase; the property names are not used.
+ * The sources are checked for changes and a new PhraseMatcher is compiled if a source has changed.
+ * The dictionary is used from one thread at a time.
+ */
+class PhraseDictionary {
+public:
+	typedef std::shared_ptr<const PhraseMatcher> MatcherPtr;
+
+	// An empty name disables the source
+	PhraseDictionary(const std::string & fileName_, const std::string & appConfigName_) :
+		fileName(fileName_), appConfigName(appConfigName_),
+		loaded(false), fileStat(), filePhrases(), appConfigProperties() {
+	}
+
+	// Compile a new matcher if this is the first load or if a source has changed since the last load
+	// Returns an empty pointer if no source has changed
+	// Throws std::runtime_error if a source can not be read; the last loaded state is kept in this case
+	MatcherPtr loadIfChanged();
+
+private:
+	// Read the file into phrases if its size, modification time or inode has changed
+	// Returns true if the file was read
+	bool readFileIfChanged(struct stat & st, std::vector<std::string> & phrases) const;
+	// Read the application configuration into sorted; returns true if the properties have changed
+	bool readAppConfigIfChanged(std::map<std::string, std::string> & sorted) const;
+
+	const std::string fileName;
+	const std::string appConfigName;
+	bool loaded;
+	// the file state and the phrases of the last file read
+	struct stat fileStat;
+	std::vector<std::string> filePhrases;
+	// the properties of the application configuration sorted by property name
+	std::map<std::string, std::string> appConfigProperties;
+};
+
+PhraseDictionary::MatcherPtr PhraseDictionary::loadIfChanged() {
+	// the state is changed only if all sources were read
+	struct stat st;
+	std::vector<std::string> newFilePhrases;
+	std::map<std::string, std::string> newProperties;
+	const bool fileChanged = readFileIfChanged(st, newFilePhrases);
+	const bool appConfigChanged = readAppConfigIfChanged(newProperties);
+	if (loaded && ! fileChanged && ! appConfigChanged)
+		return MatcherPtr();
+	if (fileChanged) {
+		fileStat = st;
+		filePhrases.swap(newFilePhrases);
+	}
+	if (appConfigChanged)
+		appConfigProperties.swap(newProperties);
+	std::vector<std::string> phrases;
+	phrases.reserve(filePhrases.size() + appConfigProperties.size());
+	phrases.insert(phrases.end(), filePhrases.begin(), filePhrases.end());
+	for (const auto & property : appConfigProperties)
+		phrases.push_back(property.second);
+	loaded = true;
+	return std::make_shared<const PhraseMatcher>(phrases);
+}
+
+bool PhraseDictionary::readFileIfChanged(struct stat & st, std::vector<std::string> & phrases) const {
+	if (fileName.empty())
+		return false;
+	if (stat(fileName.c_str(), &st) != 0)
+		throw std::runtime_error("The phrase dictionary file " + fileName + " does not exist");
+	if (loaded && (st.st_ino == fileStat.st_ino) && (st.st_size == fileStat.st_size)
+			&& (st.st_mtim.tv_sec == fileStat.st_mtim.tv_sec) && (st.st_mtim.tv_nsec == fileStat.st_mtim.tv_nsec))
+		return false;
+	std::ifstream file(fileName);
+	if ( ! file)
+		throw std::runtime_error("The phrase dictionary file " + fileName + " can not be opened");
+	std::string line;
+	while (std::getline(file, line)) {
+		const size_t start = line.find_first_not_of(" \t\r");
+		if ((start == std::string::npos) || (line[start] == '#'))
+			continue;
+		const size_t end = line.find_last_not_of(" \t\r");
+		phrases.push_back(line.substr(start, end + 1 - start));
+	}
+	if (file.bad())
+		throw std::runtime_error("The phrase dictionary file " + fileName + " can not be read");
+	return true;
+}
+
+bool PhraseDictionary::readAppConfigIfChanged(std::map<std::string, std::string> & sorted) const {
+	if (appConfigName.empty())
+		return false;
+	SPL::map<SPL::rstring, SPL::rstring> properties;
+	const SPL::int32 rc = SPL::Functions::Utility::getApplicationConfiguration(properties, appConfigName);
+	if (rc != 0)
+		throw std::runtime_error("The phrase dictionary application configuration " + appConfigName +
+				" can not be read rc=" + std::to_string(rc));
+	for (const auto & property : properties)
+		sorted.emplace(property.first, property.second);
+	return ! loaded || (sorted != appConfigProperties);
+}
+
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_PHRASEDICTIONARY_HPP_ */
@@ -0,0 +1,212 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_PHRASEMATCHER_HPP_
+#define COM_IBM_STREAMS_STTGATEWAY_PHRASEMATCHER_HPP_
+
+#include <SPL/Runtime/Type/SPLType.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+// A phrase of the dictionary found in the words of an utterance
+struct PhraseHit {
+	uint32_t phrase;         // the index of the phrase in the dictionary
+	SPL::float64 startTime;  // the start time of the first word
+	SPL::float64 endTime;    // the end time of the last word
+	SPL::float64 confidence; // the minimum word confidence or the utterance confidence
+};
+
+/*
+ * Aho-Corasick automaton over the words of a phrase dictionary
+ * The symbols of the automaton are words: a phrase matches a sequence of complete words and the matching of
+ * an utterance takes one step per word, independent of the number of phrases in the dictionary.
+ * Words are compared case insensitive (ASCII); the words of a phrase are separated by white space.
+ * The automaton is immutable after construction; one instance may be used from several threads.
+ */
+class PhraseMatcher {
+public:
+	// Compile the phrases; empty phrases are ignored and a duplicate phrase is mapped to its first entry
+	explicit PhraseMatcher(const std::vector<std::string> & phrases_);
+	PhraseMatcher(const PhraseMatcher&) = delete;
+	PhraseMatcher& operator=(const PhraseMatcher&) = delete;
+
+	// The number of distinct phrases
+	size_t size() const noexcept { return phrases.size(); }
+	// The phrase text as given in the dictionary; is used as key in the spotting results
+	const SPL::rstring & getPhrase(uint32_t idx) const { return phrases[idx]; }
+
+	// Find all phrases in words and append them to hits in the order of their last word
+	// Overlapping phrases are all reported
+	// The word times are required; the word confidences are used if they have the size of words,
+	// otherwise the utterance confidence is used
+	// wordBuffer is the working storage of the normalized word; it keeps its capacity between the calls
+	void match(const SPL::list<SPL::rstring> & words,
+			const SPL::list<SPL::float64> & wordsStartTimes,
+			const SPL::list<SPL::float64> & wordsEndTimes,
+			const SPL::list<SPL::float64> & wordsConfidences,
+			SPL::float64 utteranceConfidence,
+			std::vector<PhraseHit> & hits,
+			std::string & wordBuffer) const;
+
+	// Lower case the ASCII letters of word into buffer
+	static void normalize(const char * word, size_t len, std::string & buffer);
+
+private:
+	static const uint32_t none = std::numeric_limits<uint32_t>::max();
+	static const uint32_t root = 0;
+
+	static uint64_t transitionKey(uint32_t node, uint32_t word) { return (static_cast<uint64_t>(node) << 32) | word; }
+	// The child of node for word; none if there is no such transition
+	uint32_t getTransition(uint32_t node, uint32_t word) const {
+		const auto it = transitions.find(transitionKey(node, word));
+		return (it == transitions.end()) ? none : it->second;
+	}
+	uint32_t addNode() {
+		phraseOfNode.push_back(none);
+		failure.push_back(root);
+		output.push_back(none);
+		return static_cast<uint32_t>(phraseOfNode.size() - 1);
+	}
+
+	// the phrases and their number of words
+	std::vector<SPL::rstring> phrases;
+	std::vector<uint32_t> phraseLength;
+	// the word ids
+	std::unordered_map<std::string, uint32_t> vocabulary;
+	// the trie: the transitions keyed with node and word id
+	std::unordered_map<uint64_t, uint32_t> transitions;
+	// per node: the phrase which ends in this node, the failure link
+	// and the next node on the failure chain which ends a phrase
+	std::vector<uint32_t> phraseOfNode;
+	std::vector<uint32_t> failure;
+	std::vector<uint32_t> output;
+};
+
+const uint32_t PhraseMatcher::none;
+const uint32_t PhraseMatcher::root;
+
+PhraseMatcher::PhraseMatcher(const std::vector<std::string> & phrases_) :
+		phrases(), phraseLength(), vocabulary(), transitions(), phraseOfNode(), failure(), output() {
+	addNode();
+	// build the trie
+	std::string word;
+	for (const std::string & phrase : phrases_) {
+		uint32_t node = root;
+		uint32_t len = 0;
+		size_t pos = 0;
+		while (pos < phrase.size()) {
+			const size_t start = phrase.find_first_not_of(" \t\r\n", pos);
+			if (start == std::string::npos)
+				break;
+			size_t end = phrase.find_first_of(" \t\r\n", start);
+			if (end == std::string::npos)
+				end = phrase.size();
+			normalize(phrase.data() + start, end - start, word);
+			const auto voc = vocabulary.emplace(word, static_cast<uint32_t>(vocabulary.size())).first;
+			uint32_t next = getTransition(node, voc->second);
+			if (next == none) {
+				next = addNode();
+				transitions.emplace(transitionKey(node, voc->second), next);
+			}
+			node = next;
+			++len;
+			pos = end;
+		}
+		if ((len > 0) && (phraseOfNode[node] == none)) {
+			phraseOfNode[node] = static_cast<uint32_t>(phrases.size());
+			phrases.push_back(phrase);
+			phraseLength.push_back(len);
+		}
+	}
+	// the failure links are set in breadth first order: the failure link of a node is set before its children
+	// the children of a node are found in the transition table
+	std::vector<std::vector<std::pair<uint32_t, uint32_t> > > children(phraseOfNode.size());
+	for (const auto & t : transitions)
+		children[static_cast<uint32_t>(t.first >> 32)].emplace_back(static_cast<uint32_t>(t.first), t.second);
+	std::deque<uint32_t> queue;
+	for (const auto & child : children[root])
+		queue.push_back(child.second);
+	while ( ! queue.empty()) {
+		const uint32_t node = queue.front();
+		queue.pop_front();
+		for (const auto & child : children[node]) {
+			const uint32_t word = child.first;
+			uint32_t f = failure[node];
+			uint32_t next = getTransition(f, word);
+			while ((next == none) && (f != root)) {
+				f = failure[f];
+				next = getTransition(f, word);
+			}
+			failure[child.second] = (next == none) ? root : next;
+			queue.push_back(child.second);
+		}
+		const uint32_t f = failure[node];
+		output[node] = (phraseOfNode[f] != none) ? f : output[f];
+	}
+}
+
+void PhraseMatcher::normalize(const char * word, size_t len, std::string & buffer) {
+	buffer.assign(word, len);
+	for (char & c : buffer) {
+		if ((c >= 'A') && (c <= 'Z'))
+			c = static_cast<char>(c - 'A' + 'a');
+	}
+}
+
+void PhraseMatcher::match(const SPL::list<SPL::rstring> & words,
+		const SPL::list<SPL::float64> & wordsStartTimes,
+		const SPL::list<SPL::float64> & wordsEndTimes,
+		const SPL::list<SPL::float64> & wordsConfidences,
+		SPL::float64 utteranceConfidence,
+		std::vector<PhraseHit> & hits,
+		std::string & wordBuffer) const {
+	const size_t numWords = words.size();
+	if ((wordsStartTimes.size() != numWords) || (wordsEndTimes.size() != numWords))
+		return;
+	const bool hasWordConfidences = (wordsConfidences.size() == numWords);
+	uint32_t node = root;
+	for (size_t i = 0; i < numWords; ++i) {
+		normalize(words[i].data(), words[i].size(), wordBuffer);
+		const auto voc = vocabulary.find(wordBuffer);
+		if (voc == vocabulary.end()) {
+			// no phrase contains this word
+			node = root;
+			continue;
+		}
+		uint32_t next = getTransition(node, voc->second);
+		while ((next == none) && (node != root)) {
+			node = failure[node];
+			next = getTransition(node, voc->second);
+		}
+		node = (next == none) ? root : next;
+		// report the phrase of this node and all phrases on its failure chain
+		uint32_t n = (phraseOfNode[node] != none) ? node : output[node];
+		while (n != none) {
+			const uint32_t phrase = phraseOfNode[n];
+			const size_t first = i + 1 - phraseLength[phrase];
+			SPL::float64 confidence = utteranceConfidence;
+			if (hasWordConfidences) {
+				confidence = wordsConfidences[first];
+				for (size_t j = first + 1; j <= i; ++j) {
+					if (wordsConfidences[j] < confidence)
+						confidence = wordsConfidences[j];
+				}
+			}
+			hits.push_back(PhraseHit{phrase, wordsStartTimes[first], wordsEndTimes[i], confidence});
+			n = output[n];
+		}
+	}
+}
+
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_PHRASEMATCHER_HPP_ */
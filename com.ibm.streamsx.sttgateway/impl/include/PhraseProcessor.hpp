@@ -0,0 +1,84 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_PHRASEPROCESSOR_HPP_
+#define COM_IBM_STREAMS_STTGATEWAY_PHRASEPROCESSOR_HPP_
+
+#include <SPL/Runtime/Type/SPLType.h>
+
+#include <vector>
+
+#include "PhraseMatcher.hpp"
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+/* data struct and function to get the phrase spotting result */
+class PhraseProcessor {
+	// nullptr if there is no phrase result
+	const PhraseMatcher * const matcher;
+	const std::vector<PhraseHit> * const hits;
+
+public:
+	// matcher_ may be nullptr if no phrases were spotted
+	PhraseProcessor(const PhraseMatcher * matcher_, const std::vector<PhraseHit> & hits_);
+	PhraseProcessor();
+	PhraseProcessor(const PhraseProcessor&) = delete;
+	PhraseProcessor(PhraseProcessor&&) = delete;
+	PhraseProcessor& operator=(const PhraseProcessor&) = delete;
+	PhraseProcessor& operator=(const PhraseProcessor&&) = delete;
+	// Update the destination map with the phrase hits; the keys are the phrases of the dictionary
+	// The lists of the destination are re-used; the entries without hits are erased
+	template<typename T>
+	void getPhraseSpottingResults(SPL::map<SPL::rstring, SPL::list<T> > & destination) const;
+
+private:
+	static void setEmergence(SPL::map<SPL::rstring, SPL::float64> & t, const PhraseHit & hit) {
+		t["start_time"] = hit.startTime;
+		t["end_time"] = hit.endTime;
+		t["confidence"] = hit.confidence;
+	}
+	template<typename T>
+	static void setEmergence(T & t, const PhraseHit & hit) {
+		t.set_startTime(hit.startTime);
+		t.set_endTime(hit.endTime);
+		t.set_confidence(hit.confidence);
+	}
+};
+
+PhraseProcessor::PhraseProcessor(const PhraseMatcher * matcher_, const std::vector<PhraseHit> & hits_) :
+	matcher(matcher_),
+	hits(&hits_) {
+}
+
+PhraseProcessor::PhraseProcessor() :
+	matcher(nullptr),
+	hits(nullptr) {
+}
+
+template<typename T>
+void PhraseProcessor::getPhraseSpottingResults(SPL::map<SPL::rstring, SPL::list<T> > & destination) const {
+	if ( ! matcher || hits->empty()) {
+		destination.clear();
+		return;
+	}
+	// the lists are cleared and filled in the order of the hits; the lists without hits are erased
+	for (auto & entry : destination)
+		entry.second.clear();
+	for (const PhraseHit & hit : *hits) {
+		SPL::list<T> & emergences = destination[matcher->getPhrase(hit.phrase)];
+		emergences.resize(emergences.size() + 1);
+		setEmergence(emergences.back(), hit);
+	}
+	auto it = destination.begin();
+	while (it != destination.end()) {
+		if (it->second.empty())
+			it = destination.erase(it);
+		else
+			++it;
+	}
+}
+
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_PHRASEPROCESSOR_HPP_ */
@@ -0,0 +1,155 @@
+// **********************************************************************
+// * Copyright (C)2020, International Business Machines Corporation and *
+// * others. All Rights Reserved.                                       *
+// **********************************************************************
+
+#ifndef COM_IBM_STREAMS_STTGATEWAY_SPEAKER_PROCESSOR_H_
+#define COM_IBM_STREAMS_STTGATEWAY_SPEAKER_PROCESSOR_H_
+
+#include <string>
+#include <vector>
+
+#include <SPL/Runtime/Common/RuntimeDebug.h>
+#include <SPL/Runtime/Type/SPLType.h>
+
+#include "Decoder.hpp"
+
+namespace com { namespace ibm { namespace streams { namespace sttgateway {
+
+/*
+ * Data structure and and functions for the processing of the speaker labels
+ * The run function splits the speaker labels into two lists:
+ * 1. the list that corresponds to the utterance word list
+ * 2. the speaker updates lists
+ * Get the first list with getUtteranceWordsSpeakers() and getUtteranceWordsSpeakersConfidences()
+ * or swap it into the output tuple with the swap... functions
+ * Get the second list with getUtteranceWordsSpeakerUpdates()
+ */
+class SpeakerProcessor {
+	const rapidjson::SizeType spkSize;
+	const SPL::list<SPL::float64> & spkFrom;
+	const SPL::list<SPL::int32> &   spkSpk;
+	const SPL::list<SPL::float64> & spkCfd;
+	const size_t wordListSize;
+	const SPL::list<SPL::float64> & myUtteranceWordsStartTimes;
+	const std::string & traceIntro;
+	const std::string & payload;
+	// the speaker result lists - each entry corresponds to the entry in the word list
+	SPL::list<SPL::float64> spkFromNew;
+	SPL::list<SPL::int32>   spkSpkNew;
+	SPL::list<SPL::float64> spkCfdNew;
+	// indexes of speaker update
+	std::vector<rapidjson::SizeType> spkUpdateIndexes;
+
+public:
+	SpeakerProcessor(
+			const Decoder & dec_,
+			const SPL::list<SPL::float64> & myUtteranceWordsStartTimes_,
+			const std::string & traceIntro_,
+			const std::string & payload_);
+
+	SpeakerProcessor(const SpeakerProcessor&) = delete;
+	SpeakerProcessor(SpeakerProcessor&&) = delete;
+	SpeakerProcessor& operator=(const SpeakerProcessor&) = delete;
+	SpeakerProcessor& operator=(const SpeakerProcessor&&) = delete;
+
+	// The maximum difference of the start time of a word and the from time of a speaker label
+	// The STT service delivers the times in units of 0.01 seconds
+	static constexpr SPL::float64 timeTolerance = 0.005;
+
+	void run();
+
+	const SPL::list<SPL::int32> & getUtteranceWordsSpeakers() const { return spkSpkNew; }
+
+	const SPL::list<SPL::float64> & getUtteranceWordsSpeakersConfidences() const { return spkCfdNew; }
+
+	void swapUtteranceWordsSpeakers(SPL::list<SPL::int32> & target) noexcept { spkSpkNew.swap(target); }
+
+	void swapUtteranceWordsSpeakersConfidences(SPL::list<SPL::float64> & target) noexcept { spkCfdNew.swap(target); }
+
+	template<typename TUPLE>
+	SPL::list<TUPLE> getUtteranceWordsSpeakerUpdates() const;
+};
+
+SpeakerProcessor::SpeakerProcessor(
+		const Decoder & dec_,
+		const SPL::list<SPL::float64> & myUtteranceWordsStartTimes_,
+		const std::string & traceIntro_,
+		const std::string & payload_) :
+	spkSize(dec_.DecoderSpeakerLabels::getSize()),
+	spkFrom(dec_.DecoderSpeakerLabels::getFrom()),
+	spkSpk(dec_.DecoderSpeakerLabels::getSpeaker()),
+	spkCfd(dec_.DecoderSpeakerLabels::getConfidence()),
+	wordListSize(myUtteranceWordsStartTimes_.size()),
+	myUtteranceWordsStartTimes(myUtteranceWordsStartTimes_),
+	traceIntro(traceIntro_),
+	payload(payload_),
+	spkFromNew(),
+	spkSpkNew(),
+	spkCfdNew(),
+	spkUpdateIndexes() {
+		spkFromNew.reserve(wordListSize);
+		spkSpkNew.reserve(wordListSize);
+		spkCfdNew.reserve(wordListSize);
+}
+
+void SpeakerProcessor::run() {
+	// speaker consistency check - check the from time of the speaker labels against the from time of the words list
+	// this test guarantees that for each word in word list, a speaker label is correctly assigned
+	// if a speaker label is missing for a specific word from time, the value -1 is assigned
+	// The STT service delivers the words and the speaker labels sorted by time, thus both lists are merged in one pass.
+	// The times match if they differ less than timeTolerance.
+	// Words with the same start time get the first speaker label with this time.
+	// size check
+	if (spkSize != wordListSize) {
+		SPLAPPTRC(L_DEBUG, traceIntro << "-->RE41 Word list size " << wordListSize <<
+				" and speaker list size " << spkSize << " are not equal.", "ws_receiver");
+	}
+	// the result lists - each entry corresponds to the entry in the word list
+	// the speaker labels which are not assigned to a word are the speaker updates
+	rapidjson::SizeType spkIdx = 0;
+	bool spkIdxUsed = false;
+	for (size_t i = 0; i < wordListSize; i++) {
+		SPL::float64 startt = myUtteranceWordsStartTimes[i];
+		// skip the labels before this word
+		while ((spkIdx < spkSize) && (spkFrom[spkIdx] < startt - timeTolerance)) {
+			if ( ! spkIdxUsed)
+				spkUpdateIndexes.push_back(spkIdx);
+			++spkIdx;
+			spkIdxUsed = false;
+		}
+		if ((spkIdx < spkSize) && (spkFrom[spkIdx] <= startt + timeTolerance)) {
+			spkFromNew.push_back(spkFrom[spkIdx]);
+			spkSpkNew.push_back(spkSpk[spkIdx]);
+			spkCfdNew.push_back(spkCfd[spkIdx]);
+			spkIdxUsed = true;
+		} else {
+			SPLAPPTRC(L_ERROR, traceIntro << "-->RE40 No speaker label at: " << startt << " insert -1. payload_: " << payload, "ws_receiver");
+			spkFromNew.push_back(startt);
+			spkSpkNew.push_back(-1);
+			spkCfdNew.push_back(-1.0);
+		}
+	}
+	// the skp updates list - the labels after the last word
+	for (; spkIdx < spkSize; ++spkIdx) {
+		if ( ! spkIdxUsed)
+			spkUpdateIndexes.push_back(spkIdx);
+		spkIdxUsed = false;
+	}
+}
+
+template<typename TUPLE>
+SPL::list<TUPLE> SpeakerProcessor::getUtteranceWordsSpeakerUpdates() const {
+	SPL::list<TUPLE> destination;
+	for (size_t i = 0; i < spkUpdateIndexes.size(); ++i) {
+		TUPLE theTuple;
+		auto indx = spkUpdateIndexes[i];
+		theTuple.set_startTime(spkFrom[indx]);
+		theTuple.set_speaker(spkSpk[indx]);
+		theTuple.set_confidence(spkCfd[indx]);
+		destination.push_back(theTuple);
+	}
+	return destination;
+}
+}}}}
+#endif /* COM_IBM_STREAMS_STTGATEWAY_SPEAKER_PROCESSOR_H_ */
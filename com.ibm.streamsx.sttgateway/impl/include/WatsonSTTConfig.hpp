@@ -50,13 +50,45 @@ struct WatsonSTTConfig {
 	SPL::float64 speechDetectorSensitivity;
 	SPL::float64 backgroundAudioSuppression;
 	SPL::float64 characterInsertionBias;
+	// true if parameter conversationId is set: the operator serves multiple interleaved conversations
+	const bool multiplexed;
+	// the number of connections which are kept open in state listening for upcoming conversations
+	const SPL::int32 standbyConnections;
+	// the maximum age of a standby connection in seconds
+	const SPL::float64 standbyRefreshPeriod;
+	// the maximum size of an audio frame in bytes; larger audio data (files) are sent in chunks; 0 means no chunking
+	const SPL::int32 audioChunkSize;
+	// send the audio at this multiple of the real time rate of the contentType; 0.0 means no pacing
+	const SPL::float64 audioPacingFactor;
+	// measure the latency of the final utterances (output function getUtteranceLatency or parameter utteranceLatencyMetricsNeeded)
+	const bool utteranceLatencyNeeded;
+	// the result fields consumed by the output attributes (determined at code generation time)
+	// the decoder skips the fields which are not needed
+	const bool utteranceTextNeeded;
+	const bool utteranceWordsNeeded;
+	const bool keywordsSpottingResultsNeeded;
+	// the phrases of the dictionary are spotted in the words of the final utterances (output function getPhraseSpottingResults)
+	const bool phraseSpottingResultsNeeded;
+	// the sources of the phrase dictionary; an empty value disables the source
+	const std::string phraseDictionaryFile;
+	const std::string phraseDictionaryAppConfigName;
+	// the period in seconds of the check for changes of the phrase dictionary; 0.0 disables the reload
+	const SPL::float64 phraseDictionaryReloadPeriod;
 
 	// Some definitions
-	//This time becomes effective, when the connectionAttemptsThreshold limit is exceeded
-	static constexpr SPL::float64 receiverWaitTimeWhenIdle = 0.2;
+	// The wait times are upper limits: the state changes between sender and receiver thread are notified
+	// and wake up the waiting thread immediately. The limits guarantee the periodic check of the shutdown request.
 	static constexpr SPL::float64 senderWaitTimeForTranscriptionFinalization = 1.0;
 	static constexpr SPL::float64 senderWaitTimeForFinalReceiverState = 0.5;
 	static constexpr SPL::float64 senderWaitTimeEmptyAccessToken = 10.0;
+	// the period of the standby pool check
+	static constexpr SPL::float64 standbyCheckPeriod = 1.0;
+	// the number of audio chunks which may be queued in a connection before the sender waits
+	static constexpr SPL::int32 maxBufferedAudioChunks = 4;
+	// the wait time of the sender when the send queue of a connection is full
+	static constexpr SPL::float64 senderWaitTimeForSendQueue = 0.002;
+	// the time in seconds the paced audio may be late before the send schedule is moved forward
+	static constexpr SPL::float64 maxPacingLag = 0.5;
 	//static constexpr SPL::float64 senderPingPeriod = 5.0;
 };
 
@@ -15,7 +15,7 @@
 #include <string>
 #include <atomic>
 #include <cmath>
-#include <fstream>
+#include <memory>
 
 // This operator heavily relies on the Websocket++ header only library.
 // https://docs.websocketpp.org/index.html
@@ -47,6 +47,7 @@
 #include <SttGatewayResource.h>
 
 #include "WatsonSTTImplReceiver.hpp"
+#include "MappedAudioFile.hpp"
 
 namespace com { namespace ibm { namespace streams { namespace sttgateway {
 
@@ -74,9 +75,6 @@ public:
 	WatsonSTTImpl(OP & splOperator_, Conf config_);
 	//WatsonSTTImpl(WatsonSTTImpl const &) = delete;
 
-	//Destructor
-	~WatsonSTTImpl();
-
 protected:
 	// Notify port readiness
 	//void allPortsReady();
@@ -88,6 +86,11 @@ protected:
 	template<typename IT0, typename DATA_TYPE, DATA_TYPE const & (IT0::*GETTER)() const>
 	void process_0(IT0 const & inputTuple);
 
+	// Tuple processing for non mutating data port 0 in multiplexed mode
+	// each conversation id has its own session, an empty speech blob ends the conversation
+	template<typename IT0, typename DATA_TYPE, DATA_TYPE const & (IT0::*GETTER)() const>
+	void processMultiplexed_0(IT0 const & inputTuple, std::string const & conversationId);
+
 	// Tuple processing for non mutating authentication port 1
 	template<typename IT1, SPL::rstring const & (IT1::*GETTER)()const>
 	void process_1(IT1 const & inputTuple);
@@ -103,9 +106,19 @@ private:
 	// via port 1
 	void connect();
 
+	// replace the main session with a listening standby session if available
+	// returns false if no standby session is available
+	bool takeStandbySession();
+
+	// get the current access token
+	// blocks until a non empty access token is available
+	// returns false if the shutdown was requested during the wait
+	bool waitForAccessToken(std::string & myAccessToken);
+
 	// send the the audio data to stt if any
 	// does not take the ownership of audioBytes
-	void sendDataToSTT(unsigned char const * audioBytes, uint64_t audioSize);
+	// mapping is the file mapping of the audio data or null
+	void sendDataToSTT(unsigned char const * audioBytes, uint64_t audioSize, MappedAudioFile * mapping);
 
 	// send the action stop if connection is in listening state
 	void sendActionStop();
@@ -136,14 +149,6 @@ private:
 	// so if an window marker is directly followed by a window marker, it will be ignored
 	bool mediaEndReached;
 
-	// The list of all o tuples of an conversation
-	// The wastebasked is emptied after transcription was finalized and before a new conversation starts
-	// The transcription is finalized when, the receiver thread has finished the sending of the last tuple
-	// in a conversation and has receives the next 'listening' event, then the Rec::transcriptionFinalized flag is set
-	// from receiver thread
-	// This ensures that a o tuple is never used concurrently from sender and receiver thread
-	std::vector<OT *> oTupleWastebasket;
-
 	// Metrics completely controlled by sender thread
 	SPL::int64 nFullAudioConversationsReceived;
 	SPL::int64 nWebsocketConnectionAttempts;
@@ -164,7 +169,7 @@ private:
 // Returns true success, when the file or the blob can be acquired without issues
 // Return false when a file read error occurred
 // The audioBytes and audioSize are always the pointer/size to the extracted data
-// If a resource is allocated (the file read case) it is assigned to resource parameter
+// If a resource is allocated (the file mapping case) it is assigned to resource parameter
 // Otherwise the resource pointer is null
 // The primary template is never used so it is not defined
 template<typename DATA_TYPE>
@@ -172,7 +177,7 @@ bool getSpeechSamples(
 			DATA_TYPE const & input,
 			unsigned char const * & audioBytes,
 			uint64_t & audioSize,
-			std::vector<unsigned char> * & resource,
+			MappedAudioFile * & resource,
 			std::string & currentFileName);
 
 template<typename OP, typename OT>
@@ -188,7 +193,6 @@ WatsonSTTImpl<OP, OT>::WatsonSTTImpl(OP & splOperator_,Conf config_)
 		numberOfAudioBlobFragmentsReceivedInCurrentConversation(0),
 		numberOfAudioSendInCurrentConversation(0),
 		mediaEndReached(true),
-		oTupleWastebasket(),
 
 		nFullAudioConversationsReceived(0),
 		nWebsocketConnectionAttempts(0),
@@ -257,6 +261,34 @@ WatsonSTTImpl<OP, OT>::WatsonSTTImpl(OP & splOperator_,Conf config_)
 		throw std::runtime_error(STTGW_INVALID_PARAM_VALUE_4("WatsonSTT", Conf::maxConnectionRetryDelay,  "maxConnectionRetryDelay", "1.0"));
 	}
 
+	if (Conf::audioChunkSize < 0) {
+		throw std::runtime_error(STTGW_INVALID_PARAM_VALUE_4("WatsonSTT", Conf::audioChunkSize, "audioChunkSize", "0"));
+	}
+
+	if (Conf::audioPacingFactor < 0.0) {
+		throw std::runtime_error(STTGW_INVALID_PARAM_VALUE_4("WatsonSTT", Conf::audioPacingFactor, "audioPacingFactor", "0.0"));
+	}
+
+	if ((Conf::audioPacingFactor > 0.0) && (getAudioByteRate(Conf::contentType) <= 0.0)) {
+		throw std::invalid_argument(Conf::traceIntro + " The byte rate of contentType " + Conf::contentType +
+				" is not known. Parameter audioPacingFactor requires a raw audio format with rate: audio/l16, audio/mulaw, audio/alaw or audio/basic");
+	}
+
+	// in multiplexed mode one sender thread serves all conversations; pacing one conversation would delay the others
+	if ((Conf::audioPacingFactor > 0.0) && Conf::multiplexed) {
+		throw std::invalid_argument(Conf::traceIntro + " Parameter audioPacingFactor can not be used together with parameter conversationId");
+	}
+
+	if (Conf::phraseDictionaryReloadPeriod < 0.0) {
+		throw std::runtime_error(STTGW_INVALID_PARAM_VALUE_4("WatsonSTT", Conf::phraseDictionaryReloadPeriod, "phraseDictionaryReloadPeriod", "0.0"));
+	}
+
+	// the audio offset of the utterance end time is derived from the byte rate
+	if (Conf::utteranceLatencyNeeded && (getAudioByteRate(Conf::contentType) <= 0.0)) {
+		throw std::invalid_argument(Conf::traceIntro + " The byte rate of contentType " + Conf::contentType +
+				" is not known. The utterance latency requires a raw audio format with rate: audio/l16, audio/mulaw, audio/alaw or audio/basic");
+	}
+
 	// The parameters maxUtteranceAlternatives, wordAlternativesThreshold, keywordsSpottingThreshold, keywordsToBeSpotted
 	// are not available in sttResultMode complete
 	// The COF getUtteranceNumber, isFinalizedUtterance, getConfidence, getUtteranceAlternatives
@@ -270,7 +302,6 @@ WatsonSTTImpl<OP, OT>::WatsonSTTImpl(OP & splOperator_,Conf config_)
 	<< "\nOperatorName                            = " << Rec::splOperator.getContext().getName()
 	<< "\ncpuYieldTimeInAudioSenderThread         = " << Conf::cpuYieldTimeInAudioSenderThread
 	<< "\nmaxConnectionRetryDelay                 = " << Conf::maxConnectionRetryDelay
-	<< "\nreceiverWaitTimeWhenIdle                = " << Conf::receiverWaitTimeWhenIdle
 	<< "\nsenderWaitTimeForTranscriptionFinalization=" << Conf::senderWaitTimeForTranscriptionFinalization
 	<< "\nsenderWaitTimeForFinalReceiverState     = " << Conf::senderWaitTimeForFinalReceiverState
 	<< "\nsttLiveMetricsUpdateNeeded              = " << Conf::sttLiveMetricsUpdateNeeded
@@ -299,17 +330,18 @@ WatsonSTTImpl<OP, OT>::WatsonSTTImpl(OP & splOperator_,Conf config_)
 	<< "\nspeechDetectorSensitivity               = " << Conf::speechDetectorSensitivity
 	<< "\nbackgroundAudioSuppression              = " << Conf::backgroundAudioSuppression
 	<< "\ncharacterInsertionBias                  = " << Conf::characterInsertionBias
-	<< "\nconnectionState.wsState.is_lock_free()  = " << Rec::wsState.is_lock_free()
-	<< "\nrecentOTuple.is_lock_free()             = " << Rec::recentOTuple.is_lock_free()
+	<< "\naudioChunkSize                          = " << Conf::audioChunkSize
+	<< "\naudioPacingFactor                       = " << Conf::audioPacingFactor
+	<< "\nutteranceLatencyNeeded                  = " << Conf::utteranceLatencyNeeded
+	<< "\nphraseSpottingResultsNeeded             = " << Conf::phraseSpottingResultsNeeded
+	<< "\nphraseDictionaryFile                    = " << Conf::phraseDictionaryFile
+	<< "\nphraseDictionaryAppConfigName           = " << Conf::phraseDictionaryAppConfigName
+	<< "\nphraseDictionaryReloadPeriod            = " << Conf::phraseDictionaryReloadPeriod
+	<< "\nconnectionState.wsState.is_lock_free()  = " << Rec::mainSession->wsState.is_lock_free()
+	<< "\nrecentOTuple.is_lock_free()             = " << Rec::mainSession->recentOTuple.is_lock_free()
 	<< "\n----------------------------------------------------------------" << std::endl;
 }
 
-template<typename OP, typename OT>
-WatsonSTTImpl<OP, OT>::~WatsonSTTImpl() {
-	for (auto x : oTupleWastebasket)
-		delete x;
-}
-
 /* ping is not able to keep the connection
 template<typename OP, typename OT>
 void WatsonSTTImpl<OP, OT>::allPortsReady() {
@@ -328,28 +360,35 @@ void WatsonSTTImpl<OP, OT>::process(uint32_t idx) {
 		ping_init();
 	else
 		// run the operator receiver thread
-		Rec::ws_init();
+		Rec::ws_run();
 } */
 
 template<typename OP, typename OT>
 template<typename IT1, const SPL::rstring& (IT1::*GETTER)()const>
 void WatsonSTTImpl<OP, OT>::process_1(IT1 const & inputTuple) {
 
-	// The concurrent access from process_1 and process_0 is controlled by accessTokenMutex
-	// The receiver thread gets an own copy of access token while the receiver thread is not active (connect)
-	SPL::AutoMutex autoMutex(accessTokenMutex);
-
-	// Save the access token for subsequent use within this operator.
-	const SPL::rstring& at = (inputTuple.*GETTER)();
-	accessToken = at;
-	SPLAPPTRC(L_INFO, Conf::traceIntro << "-->Received new/refreshed access token.", "process_1");
-
-	// This must be the audio data arriving here via port 0 i.e. first input port.
-	// If we have a non-empty IAM access token, process the audio data.
-	// Otherwise, skip it.
-	if (accessToken.empty()) {
-		SPLAPPLOG(L_ERROR, STTGW_EMPTY_IAM_TOKEN("WatsonSTT"), "process_1");
+	{
+		// The concurrent access from process_1 and process_0 is controlled by accessTokenMutex
+		// The receiver thread gets an own copy of access token while the receiver thread is not active (connect)
+		SPL::AutoMutex autoMutex(accessTokenMutex);
+
+		// Save the access token for subsequent use within this operator.
+		const SPL::rstring& at = (inputTuple.*GETTER)();
+		accessToken = at;
+		SPLAPPTRC(L_INFO, Conf::traceIntro << "-->Received new/refreshed access token.", "process_1");
+
+		// This must be the audio data arriving here via port 0 i.e. first input port.
+		// If we have a non-empty IAM access token, process the audio data.
+		// Otherwise, skip it.
+		if (accessToken.empty()) {
+			SPLAPPLOG(L_ERROR, STTGW_EMPTY_IAM_TOKEN("WatsonSTT"), "process_1");
+		}
 	}
+	// wake up the sender thread if it waits for an access token
+	// the accessTokenMutex must be released here: waitForAccessToken acquires it in the wait condition
+	Rec::notifyStateChange();
+	// new standby connections use the new token
+	Rec::setStandbyAccessToken((inputTuple.*GETTER)());
 }
 
 //Definition of the template function getSpeechSamples if data type is SPL::blob
@@ -358,7 +397,7 @@ bool getSpeechSamples<SPL::blob>(
 		SPL::blob const & input,
 		unsigned char const * & audioBytes,
 		uint64_t & audioSize,
-		std::vector<unsigned char> * & resource,
+		MappedAudioFile * & resource,
 		std::string & currentFileName)
 {
 	uint64_t sizeOfBlob = SPL::Functions::Collections::blobSize(input);
@@ -381,7 +420,7 @@ bool getSpeechSamples<SPL::rstring>(
 		SPL::rstring const & input,
 		unsigned char const * & audioBytes,
 		uint64_t & audioSize,
-		std::vector<unsigned char> * & resource,
+		MappedAudioFile * & resource,
 		std::string & currentFileName)
 {
 	SPLAPPTRC(L_DEBUG, "-->Sending file " << input, "ws_sender");
@@ -405,23 +444,24 @@ bool getSpeechSamples<SPL::rstring>(
 		return false;
 
 	} else {
-		// Audio file exists. Read binary file into buffer
-		std::ifstream inputStream(input.c_str(), std::ios::binary);
-		std::vector<unsigned char>* buffer = new std::vector<unsigned char>(
-				std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>());
-		resource = buffer;
-		size_t fsize = buffer->size();
+		// Audio file exists. Map the file into memory; the file is not read into the heap.
+		// The pages are loaded when the audio chunks are sent.
+		std::unique_ptr<MappedAudioFile> mapping(new MappedAudioFile());
+		std::string errorText;
+		if (not mapping->map(input, errorText)) {
+			SPLAPPTRC(L_ERROR, "-->Audio file can not be mapped: " << errorText <<
+					". Skipping STT task for this file: " << input, "ws_sender");
+			resource = nullptr;
+			audioSize = 0; audioBytes = nullptr;
+			return false;
+		}
+		uint64_t fsize = mapping->getSize();
 		SPLAPPTRC(L_DEBUG, "-->Sending file size" << fsize, "ws_sender");
 
-		if (fsize == 0) {
-			audioBytes = nullptr;
-			audioSize = 0;
-		} else {
-			//Known problem: No error handling during read. Low risk because the existence of the file was checked before
-			// Data buffer is assigned
-			audioBytes = buffer->data();
-			audioSize = fsize;
-		}
+		// Data buffer is assigned or null for an empty file
+		audioBytes = mapping->getData();
+		audioSize = fsize;
+		resource = mapping.release();
 
 		return true;
 	} // End of if (stat(audioFileName.c_str(), &buffer) != 0)
@@ -437,7 +477,7 @@ void WatsonSTTImpl<OP, OT>::process_0(IT0 const & inputTuple) {
 	bool mediaEndReachedEntryState = mediaEndReached;
 	if (mediaEndReached) {
 		// We have a new connection attempt pending
-		Rec::nextConversationQueued.store(true);
+		Rec::mainSession->nextConversationQueued.store(true);
 
 		// this tuple starts a new conversation
 		++nFullAudioConversationsReceived;
@@ -447,24 +487,30 @@ void WatsonSTTImpl<OP, OT>::process_0(IT0 const & inputTuple) {
 			nFullAudioConversationsReceivedMetric->setValueNoLock(nFullAudioConversationsReceived);
 
 		// If the media end of the previous translation was reached, we wait until the translation has finalized.
-		// A finalized transcription is signed through Rec::transcriptionFinalized
-		// The is no need to acquire the state mutex here because we make no changes, we just wait for the transition
-		// of Rec::transcriptionFinalized to false or an inactive receiver state.
-		WsState myWsState = Rec::wsState.load();
-		while (not Rec::transcriptionFinalized.load() && not receiverHasStopped(myWsState)) {
+		// A finalized transcription is signed through Rec::mainSession->transcriptionFinalized
+		// The receiver thread notifies the transition of Rec::mainSession->transcriptionFinalized and of the state;
+		// we make no changes here, we just wait for the transition to true or an inactive receiver state.
+		WsState myWsState = Rec::mainSession->wsState.load();
+		while (not Rec::mainSession->transcriptionFinalized.load() && not receiverHasStopped(myWsState)) {
 			SPLAPPTRC(L_TRACE, Conf::traceIntro <<
 					"-->PR1 We have something to send but the previous transcription is not finalized, "
-					" wsState=" << wsStateToString(myWsState) << " block for " <<
+					" wsState=" << wsStateToString(myWsState) << " wait for max " <<
 					Conf::senderWaitTimeForTranscriptionFinalization << " second",
 					"ws_sender");
-			SPL::Functions::Utility::block(Conf::senderWaitTimeForTranscriptionFinalization);
-			myWsState = Rec::wsState.load();
+			Rec::waitForStateChange(Conf::senderWaitTimeForTranscriptionFinalization, [this]() {
+				return Rec::mainSession->transcriptionFinalized.load() || receiverHasStopped(Rec::mainSession->wsState.load())
+						|| Rec::splOperator.getPE().getShutdownRequested();
+			});
+			myWsState = Rec::mainSession->wsState.load();
 			if (Rec::splOperator.getPE().getShutdownRequested())
 				return;
 		}
 		// Here is the receiver either dead or a transcription has finalized
 		// A new transcription has not yet been started, hence no race condition can occur
-		Rec::transcriptionFinalized.store(false);
+		Rec::mainSession->transcriptionFinalized.store(false);
+		// the send schedule starts with the first audio of the conversation
+		Rec::mainSession->pacer.reset();
+		Rec::mainSession->sendTimeline.reset();
 		mediaEndReached = false;
 		// this is the first blob in a conversation
 		numberOfAudioBlobFragmentsReceivedInCurrentConversation = 0;
@@ -473,12 +519,12 @@ void WatsonSTTImpl<OP, OT>::process_0(IT0 const & inputTuple) {
 		// no current conversation is ongoing -> clear recentOTuple to be on the save side
 		// The recentOTuple is not longer needed when the transcription is finalized
 		// recentOTuple is cleared from the receiver task
-		Rec::recentOTuple.store(nullptr);
-
-		// recycle all oTuples from wastebasket
-		for (OT* x : oTupleWastebasket)
-			delete x;
-		oTupleWastebasket.clear();
+		// The output tuple of the previous conversation is reset; it may hold an error message
+		{
+			SPL::AutoMutex sessionAutoMutex(Rec::mainSession->mutex);
+			Rec::mainSession->recentOTuple.store(nullptr);
+			Rec::mainSession->conversationOTuple = OT();
+		}
 	} // END if (mediaEndReached)
 
 	// Get the file and the file read result here
@@ -487,32 +533,18 @@ void WatsonSTTImpl<OP, OT>::process_0(IT0 const & inputTuple) {
 
 	unsigned char const * myAudioBytes = nullptr;
 	uint64_t myAudioSize = 0ul;
-	std::vector<unsigned char> * buffer_ = nullptr;
+	MappedAudioFile * buffer_ = nullptr;
 	std::string currentFile;
 	bool fileReadResult = getSpeechSamples(mySpeechAttribute, myAudioBytes, myAudioSize, buffer_, currentFile);
 	// ensure release of resource with unique_ptr
-	std::unique_ptr<std::vector<unsigned char> > myBuffer(buffer_);
+	std::unique_ptr<MappedAudioFile> myBuffer(buffer_);
 
 	// This must be the audio data arriving here via port 0 i.e. first input port.
 	// If we have a non-empty IAM access token, process the audio data.
 	// Otherwise, wait until an access token is available
-	while(true) {
-		std::string myAccessToken;
-		{
-			SPL::AutoMutex autoMutex(accessTokenMutex);
-			myAccessToken = accessToken;
-		}
-		if (myAccessToken.empty()) {
-			SPLAPPTRC(L_ERROR, Conf::traceIntro << "-->PR9 Wait for access token due to an empty IAM access "
-					"token. User must first provide the IAM access token before sending any audio data to this operator.",
-					"ws_sender");
-			SPL::Functions::Utility::block(Conf::senderWaitTimeEmptyAccessToken);
-			if (Rec::splOperator.getPE().getShutdownRequested())
-				return;
-		} else {
-			break;
-		}
-	}
+	std::string myAccessToken;
+	if (not waitForAccessToken(myAccessToken))
+		return;
 
 	// log the file read error occurred
 	if (not fileReadResult) {
@@ -530,16 +562,18 @@ void WatsonSTTImpl<OP, OT>::process_0(IT0 const & inputTuple) {
 		if (Rec::splOperator.getPE().getShutdownRequested())
 			return;
 		// Do not send a tuple here because of probably multi threading issues
-		// Create an output tuple with the error text and auto assign from current input tuple
-		OT * myOTuple = Rec::splOperator.createOutTupleAndAutoAssign(inputTuple);
-		// Assign error message and send the tuple
-		Rec::splOperator.appendErrorAttribute(myOTuple, errorMsg);
-		oTupleWastebasket.push_back(myOTuple);
-		Rec::recentOTuple.store(myOTuple);
+		// Auto assign the conversation output tuple from current input tuple and assign the error text
+		// the receiver thread sends the error text with the results of the conversation
+		{
+			SPL::AutoMutex sessionAutoMutex(Rec::mainSession->mutex);
+			Rec::splOperator.autoAssignOutTuple(inputTuple, &Rec::mainSession->conversationOTuple);
+			Rec::splOperator.appendErrorAttribute(&Rec::mainSession->conversationOTuple, errorMsg);
+			Rec::mainSession->recentOTuple.store(&Rec::mainSession->conversationOTuple);
+		}
 		// here we must be in listening state
 		// ignore race condition if state enters a different state
 		mediaEndReached = true;
-		Rec::nextConversationQueued.store(false);
+		Rec::mainSession->nextConversationQueued.store(false);
 		sendActionStop();
 
 	} else { // Result success
@@ -548,9 +582,13 @@ void WatsonSTTImpl<OP, OT>::process_0(IT0 const & inputTuple) {
 			return;
 		// here we must be in listening state
 		// ignore race condition if state enters a different state
-		OT * nextOTuple = Rec::splOperator.createOutTupleAndAutoAssign(inputTuple);
-		oTupleWastebasket.push_back(nextOTuple);
-		Rec::recentOTuple.store(nextOTuple);
+		// the conversation output tuple is auto assigned in place; no output tuple is created per input tuple
+		// the receiver thread copies the conversation output tuple under the session mutex when it sends results
+		{
+			SPL::AutoMutex sessionAutoMutex(Rec::mainSession->mutex);
+			Rec::splOperator.autoAssignOutTuple(inputTuple, &Rec::mainSession->conversationOTuple);
+			Rec::mainSession->recentOTuple.store(&Rec::mainSession->conversationOTuple);
+		}
 
 		++numberOfAudioBlobFragmentsReceivedInCurrentConversation;
 		numberOfAudioSendInCurrentConversation = numberOfAudioSendInCurrentConversation + myAudioSize;
@@ -558,42 +596,135 @@ void WatsonSTTImpl<OP, OT>::process_0(IT0 const & inputTuple) {
 		if (Conf::sttLiveMetricsUpdateNeeded)
 			nAudioBytesSendMetric->setValueNoLock(nAudioBytesSend);
 
-		sendDataToSTT(myAudioBytes, myAudioSize);
+		sendDataToSTT(myAudioBytes, myAudioSize, myBuffer.get());
 		// send end in case of empty data blob
 		if (myAudioBytes == 0) {
 			mediaEndReached = true;
-			Rec::nextConversationQueued.store(false);
+			Rec::mainSession->nextConversationQueued.store(false);
 			sendActionStop();
 		}
 	}
 } // End: WatsonSTTImpl<OP, OT>::process_0
 
+template<typename OP, typename OT>
+template<typename IT0, typename DATA_TYPE, DATA_TYPE const & (IT0::*GETTER)() const>
+void WatsonSTTImpl<OP, OT>::processMultiplexed_0(IT0 const & inputTuple, std::string const & conversationId) {
+
+	// serialize this method and processPunct and protect from issues when multiple threads send to this port
+	SPL::AutoMutex autoMutex(portMutex);
+
+	// Get the file and the file read result here
+	DATA_TYPE const & mySpeechAttribute = (inputTuple.*GETTER)();
+
+	unsigned char const * myAudioBytes = nullptr;
+	uint64_t myAudioSize = 0ul;
+	MappedAudioFile * buffer_ = nullptr;
+	std::string currentFile;
+	bool fileReadResult = getSpeechSamples(mySpeechAttribute, myAudioBytes, myAudioSize, buffer_, currentFile);
+	// ensure release of resource with unique_ptr
+	std::unique_ptr<MappedAudioFile> myBuffer(buffer_);
+
+	std::string myAccessToken;
+	if (not waitForAccessToken(myAccessToken))
+		return;
+
+	typename Rec::SessionPtr s = Rec::findSession(conversationId);
+	if ( ! s && fileReadResult && (myAudioSize == 0)) {
+		SPLAPPTRC(L_DEBUG, Conf::traceIntro << "-->PR10 Ignore conversation end without ongoing conversation: " <<
+				conversationId, "ws_sender");
+		return;
+	}
+
+	std::string errorMsg;
+	if (not fileReadResult) {
+		errorMsg = Conf::traceIntro + "-->Read error in conversation " + conversationId +
+				". Close STT task. File: " + currentFile;
+		SPLAPPTRC(L_ERROR, errorMsg, "ws_sender");
+	}
+
+	if ( ! s) {
+		// this tuple starts a new conversation
+		++nFullAudioConversationsReceived;
+		SPLAPPTRC(L_INFO, Conf::traceIntro << "-->PR0 Start a new conversation number " <<
+				nFullAudioConversationsReceived << " conversationId=" << conversationId, "ws_sender");
+		if (Conf::sttLiveMetricsUpdateNeeded)
+			nFullAudioConversationsReceivedMetric->setValueNoLock(nFullAudioConversationsReceived);
+		++nWebsocketConnectionAttempts;
+		nWebsocketConnectionAttemptsMetric->setValueNoLock(nWebsocketConnectionAttempts);
+		OT myOTuple;
+		Rec::splOperator.autoAssignOutTuple(inputTuple, &myOTuple);
+		if (not fileReadResult)
+			Rec::splOperator.appendErrorAttribute(&myOTuple, errorMsg);
+		s = Rec::openSession(conversationId, myAccessToken, myOTuple);
+	} else {
+		// the conversation output tuple is auto assigned in place
+		// the receiver thread copies the conversation output tuple under the session mutex when it sends results
+		SPL::AutoMutex sessionAutoMutex(s->mutex);
+		Rec::splOperator.autoAssignOutTuple(inputTuple, &s->conversationOTuple);
+		if (not fileReadResult)
+			Rec::splOperator.appendErrorAttribute(&s->conversationOTuple, errorMsg);
+		s->recentOTuple.store(&s->conversationOTuple);
+	}
+
+	if (fileReadResult) {
+		nAudioBytesSend = nAudioBytesSend + myAudioSize;
+		if (Conf::sttLiveMetricsUpdateNeeded)
+			nAudioBytesSendMetric->setValueNoLock(nAudioBytesSend);
+		Rec::sendSessionAudio(*s, myAudioBytes, myAudioSize, myBuffer.get());
+	}
+	// send end in case of empty data blob or read error
+	if ((not fileReadResult) || (myAudioSize == 0))
+		Rec::stopSession(s);
+} // End: WatsonSTTImpl<OP, OT>::processMultiplexed_0
+
 // Punctuation processing for data port 0 Window Markers
 template<typename OP, typename OT>
 void WatsonSTTImpl<OP, OT>::processPunct_0(SPL::Punctuation const & punct) {
 	// serialize this method and process and protect from issues when multiple threads send to this port
 	SPL::AutoMutex autoMutex(portMutex);
 
+	if (Conf::multiplexed) {
+		if (punct == SPL::Punctuation::WindowMarker) {
+			SPLAPPTRC(L_TRACE, Conf::traceIntro << "PP3 Ignore window marker in multiplexed mode", "ws_sender");
+		} else if (punct == SPL::Punctuation::FinalMarker) {
+			// final marker wait until all conversations have ended
+			while ((Rec::nActiveConversations.load() > 0) && not Rec::splOperator.getPE().getShutdownRequested()) {
+				SPLAPPTRC(L_TRACE, Conf::traceIntro <<
+						"-->PP4 Final punct received wait for the end of " << Rec::nActiveConversations.load() <<
+						" conversations, wait for max " << Conf::senderWaitTimeForTranscriptionFinalization << " second",
+						"ws_sender");
+				Rec::waitForStateChange(Conf::senderWaitTimeForTranscriptionFinalization, [this]() {
+					return (Rec::nActiveConversations.load() == 0) || Rec::splOperator.getPE().getShutdownRequested();
+				});
+			}
+			Rec::splOperator.submit(punct, 0);
+		}
+		return;
+	}
+
 	if (punct == SPL::Punctuation::WindowMarker) {
 		if (not mediaEndReached) {
 			// Ignore message if not in listening state
 			mediaEndReached = true;
-			Rec::nextConversationQueued.store(false);
+			Rec::mainSession->nextConversationQueued.store(false);
 			sendActionStop();
 		} else {
 			SPLAPPTRC(L_TRACE, Conf::traceIntro << "PP1 Ignore window marker without data", "ws_sender");
 		}
 	} else if (punct == SPL::Punctuation::FinalMarker) {
 		// final marker wait until the current conversation ends if any
-		WsState myWsState = Rec::wsState.load();
-		while(not Rec::transcriptionFinalized.load() && not receiverHasStopped(myWsState) && not Rec::splOperator.getPE().getShutdownRequested()) {
+		WsState myWsState = Rec::mainSession->wsState.load();
+		while(not Rec::mainSession->transcriptionFinalized.load() && not receiverHasStopped(myWsState) && not Rec::splOperator.getPE().getShutdownRequested()) {
 			SPLAPPTRC(L_TRACE, Conf::traceIntro <<
 					"-->PP2 Final punct received wait for transcription end, "
-					" wsState=" << wsStateToString(myWsState) << " block for " <<
+					" wsState=" << wsStateToString(myWsState) << " wait for max " <<
 					Conf::senderWaitTimeForTranscriptionFinalization << " second",
 					"ws_sender");
-			SPL::Functions::Utility::block(Conf::senderWaitTimeForTranscriptionFinalization);
-			myWsState = Rec::wsState.load();
+			Rec::waitForStateChange(Conf::senderWaitTimeForTranscriptionFinalization, [this]() {
+				return Rec::mainSession->transcriptionFinalized.load() || receiverHasStopped(Rec::mainSession->wsState.load())
+						|| Rec::splOperator.getPE().getShutdownRequested();
+			});
+			myWsState = Rec::mainSession->wsState.load();
 		}
 		Rec::splOperator.submit(punct, 0);
 	}
@@ -604,7 +735,7 @@ void WatsonSTTImpl<OP, OT>::connect() {
 	SPLAPPTRC(L_DEBUG, Conf::traceIntro << "-->CS0 connect()", "ws_sender");
 
 	// We make a new connection or use a existing connection if data are to send
-	WsState myWsState = Rec::wsState.load();
+	WsState myWsState = Rec::mainSession->wsState.load();
 	bool firstLog = true;
 	while (myWsState != WsState::listening) {
 
@@ -614,9 +745,16 @@ void WatsonSTTImpl<OP, OT>::connect() {
 				firstLog = false;
 				SPLAPPTRC(L_DEBUG, Conf::traceIntro <<
 						"-->CS3 Something to sent but receiver is in transient state: " << wsStateToString(myWsState)
-						<< " wait " << Conf::senderWaitTimeForFinalReceiverState, "ws_sender");
+						<< " wait for max " << Conf::senderWaitTimeForFinalReceiverState, "ws_sender");
 			}
-			SPL::Functions::Utility::block(Conf::senderWaitTimeForFinalReceiverState);
+			// the receiver thread notifies each state change
+			Rec::waitForStateChange(Conf::senderWaitTimeForFinalReceiverState, [this]() {
+				return not receiverHasTransientState(Rec::mainSession->wsState.load())
+						|| Rec::splOperator.getPE().getShutdownRequested();
+			});
+		} else if (takeStandbySession()) {
+			// a listening standby session has become the main session
+			SPLAPPTRC(L_DEBUG, Conf::traceIntro << "-->CS4 Use standby connection", "ws_sender");
 		} else {
 			// Make a new connection attempt
 			// The receiver thread must have reached a final state
@@ -647,29 +785,76 @@ void WatsonSTTImpl<OP, OT>::connect() {
 				SPL::AutoMutex autoMutex(accessTokenMutex);
 				myAccessToken = accessToken;
 			}
-			Rec::accessToken = myAccessToken;
+			Rec::mainSession->accessToken = myAccessToken;
 
 			// make the connection attempt
-			Rec::setWsState(WsState::start);
+			Rec::setWsState(*Rec::mainSession, WsState::start);
+			Rec::requestConnection(Rec::mainSession);
 		}
 		if (Rec::splOperator.getPE().getShutdownRequested()) {
 			return;
 		}
-		myWsState = Rec::wsState.load();
+		myWsState = Rec::mainSession->wsState.load();
 	} // END: while (not connectionState.Rec::wsConnectionEstablished)
 }
 
+template<typename OP, typename OT>
+bool WatsonSTTImpl<OP, OT>::takeStandbySession() {
+	typename Rec::SessionPtr s = Rec::takeStandbySession(std::string());
+	if ( ! s)
+		return false;
+	// the conversation of the sender thread continues in the new session
+	s->nextConversationQueued.store(Rec::mainSession->nextConversationQueued.load());
+	s->transcriptionFinalized.store(Rec::mainSession->transcriptionFinalized.load());
+	{
+		// the conversation output tuple is copied into the new session
+		// the receiver thread of the previous session sends no results of this conversation anymore
+		SPL::AutoMutex sessionAutoMutex(Rec::mainSession->mutex);
+		if (Rec::mainSession->recentOTuple.exchange(nullptr)) {
+			s->conversationOTuple = Rec::mainSession->conversationOTuple;
+			s->recentOTuple.store(&s->conversationOTuple);
+		}
+	}
+	{
+		SPL::AutoMutex autoMutex(Rec::sessionsMutex);
+		Rec::mainSession = s;
+	}
+	Rec::setWsState(*s, s->wsState.load());
+	return true;
+}
+
+template<typename OP, typename OT>
+bool WatsonSTTImpl<OP, OT>::waitForAccessToken(std::string & myAccessToken) {
+	while(true) {
+		{
+			SPL::AutoMutex autoMutex(accessTokenMutex);
+			myAccessToken = accessToken;
+		}
+		if (myAccessToken.empty()) {
+			SPLAPPTRC(L_ERROR, Conf::traceIntro << "-->PR9 Wait for access token due to an empty IAM access "
+					"token. User must first provide the IAM access token before sending any audio data to this operator.",
+					"ws_sender");
+			// process_1 notifies the arrival of a new access token
+			Rec::waitForStateChange(Conf::senderWaitTimeEmptyAccessToken, [this]() {
+				SPL::AutoMutex autoMutex(accessTokenMutex);
+				return (not accessToken.empty()) || Rec::splOperator.getPE().getShutdownRequested();
+			});
+			if (Rec::splOperator.getPE().getShutdownRequested())
+				return false;
+		} else {
+			return true;
+		}
+	}
+}
+
 // send the data requires the listening state
 template<typename OP, typename OT>
-void WatsonSTTImpl<OP, OT>::sendDataToSTT(unsigned char const * audioBytes, uint64_t audioSize) {
+void WatsonSTTImpl<OP, OT>::sendDataToSTT(unsigned char const * audioBytes, uint64_t audioSize, MappedAudioFile * mapping) {
 	SPLAPPTRC(L_DEBUG, Conf::traceIntro << "-->CS0 sendDataToSTT(audioBytes=" <<
 			static_cast<const void*>(audioBytes) << ", audioSize=" << audioSize, "ws_sender");
 
 	// send bytes but only if size > 0
 	if (audioSize > 0) {
-		// put new otuple to recentOTuple and to wastebasket
-		// if nextOTuple is null, the old recentOTuple is kept
-
 		if (Conf::cpuYieldTimeInAudioSenderThread > 0.0) {
 			// Audio data available for processing. Yield the CPU briefly and get to work soon.
 			// Even a tiny value of 1 millisecond (0.001 second) will yield the
@@ -684,8 +869,10 @@ void WatsonSTTImpl<OP, OT>::sendDataToSTT(unsigned char const * audioBytes, uint
 		// Send the blob data (either in full or in a partial fragment) to the STT service.
 		// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-websockets#WSaudio
 		// c->get_alog().write(websocketpp::log::alevel::app, "Sent binary Message: " + boost::to_string(buffer.size()));
+		// Large audio data (files) are sent in chunks with back-pressure from the send queue of the connection
 		websocketpp::lib::error_code ec;
-		Rec::wsClient->send(Rec::wsHandle, audioBytes, audioSize, websocketpp::frame::opcode::binary, ec);
+		Rec::sendAudio(Rec::mainSession->wsHandle, audioBytes, audioSize, mapping, Rec::mainSession->pacer,
+				Rec::mainSession->sendTimeline, ec);
 		//Rec::statusOfAudioDataTransmissionToSTT = AUDIO_BLOB_FRAGMENTS_BEING_SENT_TO_STT;
 		if (ec) {
 			SPLAPPTRC(L_ERROR, Conf::traceIntro << "-->CS9 Error when send connectAndSendDataToSTT ec=" << ec <<
@@ -699,7 +886,7 @@ void WatsonSTTImpl<OP, OT>::sendDataToSTT(unsigned char const * audioBytes, uint
 template<typename OP, typename OT>
 void WatsonSTTImpl<OP, OT>::sendActionStop() {
 
-	WsState myWsState = Rec::wsState.load();
+	WsState myWsState = Rec::mainSession->wsState.load();
 	if (myWsState == WsState::listening) {
 
 		SPLAPPTRC(L_INFO, Conf::traceIntro << "-->CS6 Send \"action\" : \"stop\"", "ws_sender");
@@ -707,7 +894,7 @@ void WatsonSTTImpl<OP, OT>::sendActionStop() {
 		// Signal end of the audio data.
 		// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-websockets#WSstop
 		websocketpp::lib::error_code ec{};
-		Rec::wsClient->send(Rec::wsHandle, "{\"action\" : \"stop\"}" , websocketpp::frame::opcode::text, ec);
+		Rec::wsClient->send(Rec::mainSession->wsHandle, "{\"action\" : \"stop\"}" , websocketpp::frame::opcode::text, ec);
 		// In a blob based audio data, the entire blob has been sent to the STT service at this time.
 		// So set this flag to indicate that.
 		//Rec::statusOfAudioDataTransmissionToSTT = FULL_AUDIO_DATA_SENT_TO_STT;
@@ -731,10 +918,10 @@ void WatsonSTTImpl<OP, OT>::ping_init() {
 		SPL::Functions::Utility::block(Conf::senderPingPeriod);
 		if (not Rec::splOperator.getPE().getShutdownRequested()) {
 
-			if (Rec::wsState.load() == WsState::listening) {
+			if (Rec::mainSession->wsState.load() == WsState::listening) {
 				std::string pingmessage{"pong_" + std::to_string(pingSequenceNumber++)};
 				websocketpp::lib::error_code ec{};
-				Rec::wsClient->ping(Rec::wsHandle, pingmessage, ec);
+				Rec::wsClient->ping(Rec::mainSession->wsHandle, pingmessage, ec);
 				if (ec)
 					SPLAPPTRC(L_ERROR, Conf::traceIntro << "-->CS99 Error when send ping ec=" << ec << " message=" << ec.message(), "ws_sender");
 			}
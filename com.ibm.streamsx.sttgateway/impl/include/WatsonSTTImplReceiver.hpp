@@ -14,7 +14,14 @@
 
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
@@ -38,6 +45,9 @@
 
 #include <boost/exception/to_string.hpp>
 
+// The TLS session of a connection is re-used with the OpenSSL api
+#include <openssl/ssl.h>
+
 // SPL Operator related includes
 #include <SPL/Runtime/Type/SPLType.h>
 #include <SPL/Runtime/Function/SPLFunctions.h>
@@ -46,6 +56,13 @@
 
 #include "WatsonSTTConfig.hpp"
 #include "Decoder.hpp"
+#include "MappedAudioFile.hpp"
+#include "AudioPacer.hpp"
+#include "AudioSendTimeline.hpp"
+#include "SpeakerProcessor.hpp"
+#include "KeywordProcessor.hpp"
+#include "PhraseDictionary.hpp"
+#include "PhraseProcessor.hpp"
 
 //#include <SttGatewayResource.h>
 
@@ -67,7 +84,7 @@ enum class WsState : char {
 	error,      // error received during transcription (error message received on message) - transient
 	closed,     // connection has closed (on close event) - stable state
 	failed,     // connection has failed (on fail event) - stable state
-	crashed     // Error was caught in ws_init (receiver thread)- stable state
+	crashed     // Error was caught in the receiver thread - stable state
 };
 // helper function to make a pretty print
 const char * wsStateToString(WsState ws);
@@ -76,8 +93,98 @@ bool receiverHasStopped(WsState ws);
 // helper function to determine whether the receiver is in a transient state
 bool receiverHasTransientState(WsState ws);
 
-class SpeakerProcessor;
-class KeywordProcessor;
+/*
+ * The state of one websocket session with the STT service
+ * In the default mode the operator drives exactly one session (mainSession) which is re-connected for
+ * subsequent conversations.
+ * In multiplexed mode (parameter conversationId) each ongoing conversation has its own session. All sessions
+ * are served from the one receiver thread and the one websocket client. A session lives until its connection
+ * has closed or failed.
+ * With parameter standbyConnections, sessions are opened in advance and wait in state listening in the standby
+ * pool until a conversation takes them.
+ *
+ * Template argument : OT: Output Tuple type
+ */
+template<typename OT>
+struct WatsonSTTSession {
+	WatsonSTTSession(const WatsonSTTConfig & config_, const std::string & conversationId_);
+	WatsonSTTSession(const WatsonSTTSession&) = delete;
+	WatsonSTTSession& operator=(const WatsonSTTSession&) = delete;
+
+	// The conversation id of this session (empty in default mode)
+	// The id of a standby session is assigned under mutex when the session is taken from the standby pool
+	std::string conversationId;
+
+	// Websocket operations related member variables.
+	// values set from receiver thread and read from sender side
+	// All values are primitive atomic values, no locking
+	std::atomic<WsState> wsState;
+
+	// this flag us set from receiver thread and reset from sender thread
+	// it is set at the end of the on_message method, when the stt service sends a 'listening' event
+	// after transcription
+	std::atomic<bool> transcriptionFinalized;
+
+	// This is set from the sender thread when the the next conversation is queued
+	// If this flag is set when a transcription completes, the connection is kept
+	// Otherwise the connection is closed to avoid the race condition when the next conversation arrives
+	// In multiplexed mode this flag is never set: a session serves exactly one conversation
+	std::atomic<bool> nextConversationQueued;
+
+	// This value is set from receiver thread when state is connecting
+	// the sender thread requires the values but should not use them during connecting state
+	websocketpp::connection_hdl wsHandle;
+
+	// the access token used in receiver-thread in connectSession after wsState changes to 'start'
+	// the value is copied from the sender- to receiver-thread before a 'makeNewWebsocketConnection' has been flagged
+	// this is a change of wsStae from any state to 'start'
+	std::string accessToken;
+
+	// The tuple with assignments from the most recent input tuple of the conversation
+	// The sender thread changes the assignments in place under mutex when the input receives new input tuples for
+	// the current transcription. The receiver thread never submits this tuple; it copies the tuple under mutex
+	// into resultOTuple when transcription results or error indications have to be sent.
+	OT conversationOTuple;
+	// Points to conversationOTuple while a conversation is ongoing, otherwise null
+	// The sender thread sets the value under mutex, the receiver thread clears the value when the conversation ends
+	std::atomic<OT *> recentOTuple;
+	// The output tuple of the receiver thread with the assignments of conversationOTuple and the result attributes
+	// Thus a conversation needs two output tuples regardless of the number of input tuples
+	OT resultOTuple;
+
+	// when the on_message method is about to send something, this member is used to store the
+	// output tuple pointer (resultOTuple).
+	// First we expect the results for utterance, alternatives, and word alternatives
+	// Then we expect the speaker results.
+	// This value is used to store the non output tuple contains with the utterances and related attributes
+	// until the appropriate speaker result is received.
+	// The member is reset, after the tuple was submitted
+	OT * oTupleUsedForSubmission;
+
+	// Decoder class for json decoding
+	Decoder dec;
+	// list of the words start times used for the speaker label consistency check
+	SPL::list<SPL::float64> myUtteranceWordsStartTimes;
+
+	// The mutex serializes the sender thread and the receiver thread for the access to wsHandle,
+	// pendingAudio, stopRequested, inStandby and conversationOTuple and for the transition into state listening
+	SPL::Mutex mutex;
+	// audio received before the session has reached state listening
+	std::vector<unsigned char> pendingAudio;
+	// the end of the conversation was received from the sender thread
+	bool stopRequested;
+
+	// The session waits in the standby pool and has no conversation
+	// The flag is reset under mutex when the session is taken from the pool
+	std::atomic<bool> inStandby;
+	// The time when the standby session was created; standby sessions are renewed after standbyRefreshPeriod
+	std::chrono::steady_clock::time_point standbySince;
+
+	// The send schedule of the audio if parameter audioPacingFactor is set (used in sender thread only)
+	AudioPacer pacer;
+	// The send times of the audio if the utterance latency is measured
+	AudioSendTimeline sendTimeline;
+};
 
 /*
  * Implementation class for operator Watson STT
@@ -90,6 +197,8 @@ template<typename OP, typename OT>
 class WatsonSTTImplReceiver : public WatsonSTTConfig {
 public:
 	typedef WatsonSTTConfig Config;
+	typedef WatsonSTTSession<OT> Session;
+	typedef std::shared_ptr<Session> SessionPtr;
 	typedef struct { SPL::float64 startTime; SPL::int32 speaker; SPL::float64 confidence; } SpeakerUpdatesStruct;
 	//Constructors
 	WatsonSTTImplReceiver(OP & splOperator_, Config config_);
@@ -110,196 +219,291 @@ protected:
 
 private:
 	// Websocket connection open event handler
-	void on_open(client* c, websocketpp::connection_hdl hdl);
+	void on_open(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl);
 
 	// Websocket message reception event handler
-	void on_message(client* c, websocketpp::connection_hdl hdl, message_ptr msg);
+	void on_message(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl, message_ptr msg);
+
+	// Multiplexed mode: message handler of a session; an exception fails the conversation of this session only
+	void on_session_message(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl, message_ptr msg);
 
 	// Websocket connection close event handler
-	void on_close(client* c, websocketpp::connection_hdl hdl);
+	void on_close(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl);
 
 	// Websocket TLS binding event handler
 	context_ptr on_tls_init(client* c, websocketpp::connection_hdl);
 
+	// TLS socket initialization handler: offers the cached TLS session for resumption
+	void on_socket_init(websocketpp::connection_hdl, boost::asio::ssl::stream<boost::asio::ip::tcp::socket> & sslStream);
+
 	// Webscoket connection failure event handler
-	void on_fail(client* c, websocketpp::connection_hdl hdl);
+	void on_fail(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl);
 
 	//bool on_ping(client* c, websocketpp::connection_hdl hdl, std::string mess);
 
 	//void on_pong(client* c, websocketpp::connection_hdl hdl, std::string mess);
 
-	// Websocket initialization thread method
-	void ws_init();
+	// Receiver thread method: runs the io loop of the client until shutdown
+	void ws_run();
 
-protected:
-	OP & splOperator;
+	// Create the websocket client, set the logging channels, initialize asio and set the tls handlers
+	void initClient();
 
-	// Websocket operations related member variables.
-	// values set from receiver thread and read from sender side
-	// All values are primitive atomic values, no locking
-	std::atomic<WsState> wsState;
+	// Build the connection uri with the given access token
+	std::string getConnectionUri(const std::string & accessToken_) const;
 
-	// this flag us set from receiver thread and reset from sender thread
-	// it is set at the end of the on_message method, when the stt service sends a 'listening' event
-	// after transcription
-	std::atomic<bool> transcriptionFinalized;
+	// Create the connection for a session (runs in receiver thread)
+	void connectSession(SessionPtr s);
 
-	// This is set from the sender thread when the the next conversation is queued
-	// If this flag is set when a transcription completes, the connection is kept
-	// Otherwise the connection is closed to avoid the race condition when the next conversation arrives
-	std::atomic<bool> nextConversationQueued;
+	// Check whether hdl is the current connection of the session
+	// Events of a previous connection of a session must not change the session state
+	static bool isCurrentConnection(Session & s, websocketpp::connection_hdl hdl);
 
-	// This values are set from receiver thread when state is connecting
-	// the sender thread requires the values but should not use them during connecting state
+	// Multiplexed mode: a session has reached its final state: remove it from the session table
+	void finishSession(const SessionPtr & s);
+
+	// Single mode: terminate the connection of the main session after an exception in the io loop
+	void abortMainConnection();
+
+	// Multiplexed mode: send the error of a session and terminate its connection after an exception in its handler
+	void abortSessionConnection(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl, const std::string & reason);
+
+	// Standby pool: remove the stale sessions and open new sessions until standbyConnections sessions are
+	// available. Runs in receiver thread and re-arms the standby timer
+	void replenishStandby();
+
+	// Standby timer event handler
+	void on_standby_timer(const boost::system::error_code & ec);
+
+	// Standby pool: cancel the timer and close all standby sessions (runs in receiver thread)
+	void stopStandby();
+
+	// Standby pool: close a session which leaves the pool without a conversation
+	void retireStandbySession(const SessionPtr & s);
+
+	// Phrase dictionary thread method: checks the dictionary for changes every phraseDictionaryReloadPeriod
+	// seconds until shutdown
+	void phraseDictionary_run();
+
+	// Load the phrase dictionary if it has changed and publish the new phrase matcher
+	// Throws if the dictionary can not be read
+	void loadPhraseDictionary();
+
+	// Spot the phrases of the dictionary in the words of the final utterance of the decoder
+	// The hits are stored in phraseHits; returns the phrase matcher which was used or an empty pointer
+	PhraseDictionary::MatcherPtr spotPhrases(Session & s);
+
+protected:
+	OP & splOperator;
+
+	// The session used in default mode
+	// The session is replaced with a standby session from the sender thread; this is done under sessionsMutex
+	// The receiver thread must get the main session with getMainSession
+	SessionPtr mainSession;
+
+	// The client is created in allPortsReady and is used for all connections of this operator
+	// The io loop of the client runs in the receiver thread
 	client *wsClient;
-	websocketpp::connection_hdl wsHandle;
 
-	// the access token used in receiver-thread during ws_init after wsState changes to 'start'
-	// the value is copied from the sender- to receiver-thread before a 'makeNewWebsocketConnection' has been flagged
-	// this is a change of wsStae from any state to 'start'
-	std::string accessToken;
+	// The TLS context is created once and is used for all connections
+	// The TLS session of the last successful connection is offered for resumption in subsequent handshakes
+	// Both values are used from the receiver thread only
+	context_ptr sslContext;
+	SSL_SESSION * sslSession;
+
+	// Multiplexed mode: the table of the ongoing conversations
+	// Access is controlled by sessionsMutex
+	SPL::Mutex sessionsMutex;
+	std::unordered_map<std::string, SessionPtr> sessions;
+	// Multiplexed mode: the number of sessions which have not yet reached a final state
+	std::atomic<SPL::int64> nActiveConversations;
+
+	// The pool of the standby sessions and the access token for new standby sessions
+	// Access is controlled by sessionsMutex
+	std::deque<SessionPtr> standbySessions;
+	std::string standbyAccessToken;
+	// The timer for the periodic check of the standby pool (used in receiver thread only)
+	std::unique_ptr<boost::asio::steady_timer> standbyTimer;
+
+	// The byte rate of the audio sent to the STT service if pacing is enabled (parameter audioPacingFactor)
+	// The value is 0.0 if the audio is sent as fast as the connection accepts it
+	const double pacedAudioByteRate;
+	// The byte rate of the audio; used to get the audio offset of an utterance end time if the utterance latency is measured
+	const double audioByteRate;
+
+	// Notification of state changes between sender and receiver thread
+	// The state values themselves are atomics; the mutex only guards the wait and notify operations
+	// so that no notification is lost between the check of the wait condition and the wait
+	std::mutex stateChangeMutex;
+	std::condition_variable stateChangeCondition;
 
-	// The tuple with assignments from the input port
-	// to be used if transcription results or error indications have to be sent
-	// the sender thread guarantees that here is an valid value until transcriptionFinalized is flagged
-	// this otuple may change during a transcription when the input receives new input tuples for the
-	// current transcription. The previous value remains valid until transcriptionFinalized is flagged.
-	std::atomic<OT *> recentOTuple;
 private:
-	// when the on_message method is about to send something, this member is used to store the
-	// output tuple pointer.
-	// First we expect the results for utterance, alternatives, and word alternatives
-	// Then we expect the speaker results.
-	// This value is used to store the non output tuple contains with the utterances and related attributes
-	// until the appropriate speaker result is received.
-	// The member is reset, after the tuple was submitted
-	OT * oTupleUsedForSubmission;
-
 	std::atomic<SPL::int64> nWebsocketConnectionAttemptsCurrent;
 	std::atomic<SPL::int64> nFullAudioConversationsTranscribed;
 	std::atomic<SPL::int64> nFullAudioConversationsFailed;
 
-	// Decoder class for json decoding
-	Decoder dec;
-	// list of the words start times used for the speaker label consistency check
-	SPL::list<SPL::float64> myUtteranceWordsStartTimes;
 	// Custom metrics for this operator.
 	SPL::Metric * const nWebsocketConnectionAttemptsCurrentMetric;
 	SPL::Metric * const nFullAudioConversationsTranscribedMetric;
 	SPL::Metric * const nFullAudioConversationsFailedMetric;
 	SPL::Metric * const wsConnectionStateMetric;
+	SPL::Metric * const nActiveConversationsMetric;
+	SPL::Metric * const nStandbyConnectionsMetric;
+
+	// The histogram of the utterance latency (used in receiver thread only)
+	// The bucket i counts the latencies up to utteranceLatencyBucketBounds[i] milliseconds; the last bucket
+	// counts all larger latencies
+	static const size_t numUtteranceLatencyBuckets = 5;
+	static const SPL::int64 utteranceLatencyBucketBounds[numUtteranceLatencyBuckets - 1];
+	SPL::int64 nUtteranceLatency[numUtteranceLatencyBuckets];
+	SPL::int64 nUtteranceLatencyTotalMs;
+	SPL::int64 utteranceLatencyMaxMs;
+	SPL::Metric * nUtteranceLatencyMetrics[numUtteranceLatencyBuckets];
+	SPL::Metric * const nUtteranceLatencyTotalMsMetric;
+	SPL::Metric * const utteranceLatencyMaxMsMetric;
+
+	// The phrase dictionary is loaded in allPortsReady and reloaded in the phrase dictionary thread
+	// The current phrase matcher is exchanged with atomic operations; the receiver thread keeps its copy
+	// of the pointer while a result is processed
+	PhraseDictionary phraseDictionary;
+	PhraseDictionary::MatcherPtr phraseMatcher;
+	// The phrase hits of the current result and the working storage of the matcher (used in receiver thread only)
+	std::vector<PhraseHit> phraseHits;
+	std::string phraseWordBuffer;
+	SPL::int64 nPhraseDictionaryReloads;
+	SPL::Metric * const nPhrasesInDictionaryMetric;
+	SPL::Metric * const nPhraseDictionaryReloadsMetric;
 
-	static const SpeakerProcessor emptySpeakerResults;
 	static const KeywordProcessor emptyKeywordProcessor;
+	static const PhraseProcessor emptyPhraseProcessor;
 
 protected:
 	// Helper functions
-	void setWsState(WsState ws);
+	void setWsState(Session & s, WsState ws);
 	inline void incrementNWebsocketConnectionAttemptsCurrent();
 	inline void incrementNFullAudioConversationsTranscribed();
 	inline void incrementNFullAudioConversationsFailed();
 	inline SPL::float64 getNWebsocketConnectionAttemptsCurrent() { return nWebsocketConnectionAttemptsCurrent.load(); };
 
-private:
-	// send out the error with the wit the specified reason
-	// This function consumes a non finalized output tuple (oTupleUsedForSubmission) if any
-	// Or uses a the recent output tuple (recentOTuple).
-	// If no recent output tuple is available, no tuple is sent and an error log is emitted
-	// increment the FullAudioConversationsFailed
-	void sendErrorTuple(const std::string & reason);
+	// Get the time in seconds from the send time of the audio at the utterance end time until now
+	// and record it in the utterance latency metrics
+	// Returns -1.0 if the send time of this audio is not known
+	SPL::float64 measureUtteranceLatency(Session & s, SPL::float64 utteranceEndTime);
 
-	// send the finalization tuple of an conversation
-	void sendTranscriptionCompletedTuple(OT * otuple);
-};
+	// Wake up all threads waiting in waitForStateChange
+	// Must be called after a change of a value which is used in a wait condition
+	void notifyStateChange();
 
-/*
- * Data structure and and functions for the processing of the speaker labels
- * The run function splits the speaker labels into two lists:
- * 1. the list that corresponds to the utterance word list
- * 2. the speaker updates lists
- * Get the first list with getUtteranceWordsSpeakers() and getUtteranceWordsSpeakersConfidences()
- * Get the second list with getUtteranceWordsSpeakerUpdates()
- */
-class SpeakerProcessor {
-	const rapidjson::SizeType spkSize;
-	const SPL::list<SPL::float64> & spkFrom;
-	const SPL::list<SPL::int32> &   spkSpk;
-	const SPL::list<SPL::float64> & spkCfd;
-	const size_t wordListSize;
-	const SPL::list<SPL::float64> & myUtteranceWordsStartTimes;
-	const std::string & traceIntro;
-	const std::string & payload;
-	// the speaker result lists - each entry corresponds to the entry in the word list
-	SPL::list<SPL::float64> spkFromNew;
-	SPL::list<SPL::int32>   spkSpkNew;
-	SPL::list<SPL::float64> spkCfdNew;
-	// indexes of speaker update
-	std::vector<rapidjson::SizeType> spkUpdateIndexes;
+	// Wait until pred returns true or maxWaitTime (seconds) has expired
+	// Returns the value of pred
+	template<typename PRED>
+	bool waitForStateChange(SPL::float64 maxWaitTime, PRED pred);
 
-public:
-	SpeakerProcessor(
-			const Decoder & dec_,
-			const SPL::list<SPL::float64> & myUtteranceWordsStartTimes_,
-			const std::string & traceIntro_,
-			const std::string & payload_);
+	// Multiplexed mode: get the ongoing session of a conversation; returns an empty pointer if there is none
+	SessionPtr findSession(const std::string & conversationId);
 
-	SpeakerProcessor();
+	// Trigger the connection of a session; the connection is made in the receiver thread
+	// The session must be in state start
+	void requestConnection(const SessionPtr & s);
 
-	SpeakerProcessor(const SpeakerProcessor&) = delete;
-	SpeakerProcessor(SpeakerProcessor&&) = delete;
-	SpeakerProcessor& operator=(const SpeakerProcessor&) = delete;
-	SpeakerProcessor& operator=(const SpeakerProcessor&&) = delete;
+	// Get the main session; used from the receiver thread
+	SessionPtr getMainSession();
 
-	void run();
+	// Standby pool: take a listening session from the pool and assign the conversation id
+	// Returns an empty pointer if no listening session is available
+	SessionPtr takeStandbySession(const std::string & conversationId);
 
-	SPL::list<SPL::int32> getUtteranceWordsSpeakers() const { return spkSpkNew; }
+	// Standby pool: store the access token used for new standby sessions and trigger the replenishment
+	void setStandbyAccessToken(const std::string & accessToken_);
 
-	SPL::list<SPL::float64> getUtteranceWordsSpeakersConfidences() const { return spkCfdNew; }
+	// Multiplexed mode: create a new session for a conversation and trigger the connection
+	// The assignments of the first input tuple of the conversation must be passed with otuple
+	SessionPtr openSession(const std::string & conversationId, const std::string & accessToken_, const OT & otuple);
 
-	template<typename TUPLE>
-	SPL::list<TUPLE> getUtteranceWordsSpeakerUpdates() const;
-};
+	// Send the audio over the connection hdl in chunks of audioChunkSize bytes
+	// Before a chunk is sent, wait while the send queue of the connection holds more than maxBufferedAudioChunks chunks
+	// In multiplexed mode the sender thread does not wait: a slow connection must not stall the other conversations
+	// If mapping is not null, the pages of the audio file are released when they are sent
+	// If pacing is enabled, each chunk is sent when it is due in the schedule of the pacer
+	// Must not be called with a session mutex held: the receiver thread must be able to drain the send queue
+	// If the utterance latency is measured, the send time of each chunk is recorded in the timeline
+	void sendAudio(websocketpp::connection_hdl hdl, unsigned char const * audioBytes, uint64_t audioSize,
+			MappedAudioFile * mapping, AudioPacer & pacer, AudioSendTimeline & timeline, websocketpp::lib::error_code & ec);
 
-/* data struct and function to get the keyword result */
-class KeywordProcessor {
-	const bool isEmpty;
-	const DecoderKeywordsResult::ResultMapType & keywordResults;
+	// Multiplexed mode: send the audio if the session is listening, queue it if the session is not yet listening
+	void sendSessionAudio(Session & s, unsigned char const * audioBytes, uint64_t audioSize, MappedAudioFile * mapping);
 
-public:
-	KeywordProcessor(const DecoderKeywordsResult::ResultMapType & keywordResults_);
-	KeywordProcessor();
-	KeywordProcessor(const KeywordProcessor&) = delete;
-	KeywordProcessor(KeywordProcessor&&) = delete;
-	KeywordProcessor& operator=(const KeywordProcessor&) = delete;
-	KeywordProcessor& operator=(const KeywordProcessor&&) = delete;
-	template<typename T>
-	void getKeywordsSpottingResults(SPL::map<SPL::rstring, SPL::list<T> > & destination) const;
+	// Multiplexed mode: flag the end of the conversation and send the action stop if the session is listening
+	// The session is removed from the session table thus the next audio with this conversation id starts a new session
+	void stopSession(const SessionPtr & s);
+
+private:
+	// send out the error with the wit the specified reason
+	// This function consumes a non finalized output tuple (oTupleUsedForSubmission) if any
+	// Or uses a copy of the conversation output tuple (recentOTuple).
+	// If no recent output tuple is available, no tuple is sent and an error log is emitted
+	// increment the FullAudioConversationsFailed
+	void sendErrorTuple(Session & s, const std::string & reason);
+
+	// send the finalization tuple of an conversation
+	void sendTranscriptionCompletedTuple(OT * otuple);
+
+	// copy the conversation output tuple into the result output tuple of the session
+	// A non finalized output tuple (oTupleUsedForSubmission) is sent before it is overwritten
+	// Returns the result output tuple or null if no conversation is ongoing
+	OT * loadResultOTuple(Session & s);
 };
 
 typename SPL::map<SPL::rstring, SPL::float64> KeyWordEmergenceMap;
 
-template<typename OP, typename OT>
-WatsonSTTImplReceiver<OP, OT>::WatsonSTTImplReceiver(OP & splOperator_,Config config_)
+template<typename OT>
+WatsonSTTSession<OT>::WatsonSTTSession(const WatsonSTTConfig & config_, const std::string & conversationId_)
 :
-		Config(config_),
-		splOperator(splOperator_),
-
+		conversationId(conversationId_),
 		wsState{WsState::idle},
 		transcriptionFinalized(true),
 		nextConversationQueued(false),
-		wsClient(nullptr),
 		wsHandle{},
-
 		accessToken{},
-
+		conversationOTuple(),
 		recentOTuple{},
+		resultOTuple(),
 		oTupleUsedForSubmission{},
+		dec(config_),
+		myUtteranceWordsStartTimes(),
+		mutex(),
+		pendingAudio(),
+		stopRequested(false),
+		inStandby{false},
+		standbySince(),
+		pacer(),
+		sendTimeline()
+{
+}
+
+template<typename OP, typename OT>
+WatsonSTTImplReceiver<OP, OT>::WatsonSTTImplReceiver(OP & splOperator_,Config config_)
+:
+		Config(config_),
+		splOperator(splOperator_),
+
+		mainSession(std::make_shared<Session>(*this, std::string())),
+		wsClient(nullptr),
+		sslContext(),
+		sslSession(nullptr),
+
+		sessionsMutex(),
+		sessions(),
+		nActiveConversations{0},
+		standbySessions(),
+		standbyAccessToken(),
+		standbyTimer(),
+		pacedAudioByteRate(getAudioByteRate(contentType) * audioPacingFactor),
+		audioByteRate(getAudioByteRate(contentType)),
 
 		nWebsocketConnectionAttemptsCurrent{0},
 		nFullAudioConversationsTranscribed{0},
 		nFullAudioConversationsFailed{0},
-		dec(*this),
-		myUtteranceWordsStartTimes(),
 
 		// Custom metrics for this operator are already defined in the operator model XML file.
 		// Hence, there is no need to explicitly create them here.
@@ -308,22 +512,73 @@ WatsonSTTImplReceiver<OP, OT>::WatsonSTTImplReceiver(OP & splOperator_,Config co
 		nWebsocketConnectionAttemptsCurrentMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("nWebsocketConnectionAttemptsCurrent")},
 		nFullAudioConversationsTranscribedMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("nFullAudioConversationsTranscribed")},
 		nFullAudioConversationsFailedMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("nFullAudioConversationsFailed")},
-		wsConnectionStateMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("wsConnectionState")}
+		wsConnectionStateMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("wsConnectionState")},
+		nActiveConversationsMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("nActiveConversations")},
+		nStandbyConnectionsMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("nStandbyConnections")},
+		nUtteranceLatencyTotalMs{0},
+		utteranceLatencyMaxMs{0},
+		nUtteranceLatencyTotalMsMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("nUtteranceLatencyTotalMs")},
+		utteranceLatencyMaxMsMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("utteranceLatencyMaxMs")},
+		// a relative dictionary file name is relative to the application directory
+		phraseDictionary(
+				(phraseDictionaryFile.empty() || (phraseDictionaryFile[0] == '/')) ? phraseDictionaryFile
+						: splOperator.getPE().getApplicationDirectory() + "/" + phraseDictionaryFile,
+				phraseDictionaryAppConfigName),
+		phraseMatcher(),
+		phraseHits(),
+		phraseWordBuffer(),
+		nPhraseDictionaryReloads{0},
+		nPhrasesInDictionaryMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("nPhrasesInDictionary")},
+		nPhraseDictionaryReloadsMetric{ & splOperator.getContext().getMetrics().getCustomMetricByName("nPhraseDictionaryReloads")},
+
+		stateChangeMutex(),
+		stateChangeCondition()
 {
+	const char * utteranceLatencyMetricNames[numUtteranceLatencyBuckets] = {
+			"nUtteranceLatencyUpTo500ms", "nUtteranceLatencyUpTo1000ms", "nUtteranceLatencyUpTo2000ms",
+			"nUtteranceLatencyUpTo4000ms", "nUtteranceLatencyAbove4000ms" };
+	for (size_t i = 0; i < numUtteranceLatencyBuckets; ++i) {
+		nUtteranceLatency[i] = 0;
+		nUtteranceLatencyMetrics[i] = & splOperator.getContext().getMetrics().getCustomMetricByName(utteranceLatencyMetricNames[i]);
+	}
 	std::cout << "nFullAudioConversationsTranscribed.is_lock_free()= " << nFullAudioConversationsTranscribed.is_lock_free() << std::endl;
 }
 
 template<typename OP, typename OT>
 WatsonSTTImplReceiver<OP, OT>::~WatsonSTTImplReceiver() {
+	// release the sessions and the timer before the client is deleted
+	sessions.clear();
+	standbySessions.clear();
+	standbyTimer.reset();
 	if (wsClient) {
 		delete wsClient;
 	}
+	if (sslSession)
+		SSL_SESSION_free(sslSession);
 }
 
 template<typename OP, typename OT>
 void WatsonSTTImplReceiver<OP, OT>::allPortsReady() {
-	// create the operator receiver thread
-	uint32_t userThreadIndex = splOperator.createThreads(1);
+	// The client must exist before the first tuple arrives
+	initClient();
+	// The io loop must not return when no connection is active
+	wsClient->start_perpetual();
+	if (standbyConnections > 0) {
+		standbyTimer.reset(new boost::asio::steady_timer(wsClient->get_io_service()));
+		wsClient->get_io_service().post(bind(&WatsonSTTImplReceiver<OP, OT>::replenishStandby, this));
+	}
+	// The phrase dictionary must be available before the first result arrives
+	// A dictionary which can not be read at startup is a configuration error
+	if (phraseSpottingResultsNeeded) {
+		try {
+			loadPhraseDictionary();
+		} catch (const std::exception & e) {
+			throw std::invalid_argument(traceIntro + " " + e.what());
+		}
+	}
+	// create the operator receiver thread and the phrase dictionary thread if the dictionary is reloaded
+	const bool phraseDictionaryReloadNeeded = phraseSpottingResultsNeeded && (phraseDictionaryReloadPeriod > 0.0);
+	uint32_t userThreadIndex = splOperator.createThreads(phraseDictionaryReloadNeeded ? 2 : 1);
 	if (userThreadIndex != 0) {
 		throw std::invalid_argument(traceIntro +" WatsonSTTImpl invalid userThreadIndex");
 	}
@@ -331,6 +586,41 @@ void WatsonSTTImplReceiver<OP, OT>::allPortsReady() {
 
 template<typename OP, typename OT>
 void WatsonSTTImplReceiver<OP, OT>::prepareToShutdown() {
+	// wake up the waiting threads; they check the shutdown request
+	notifyStateChange();
+	if (wsClient && standbyTimer) {
+		// the timer and the standby sessions are used in the receiver thread only
+		wsClient->get_io_service().post(bind(&WatsonSTTImplReceiver<OP, OT>::stopStandby, this));
+	}
+	if (multiplexed) {
+		try {
+			if (wsClient) {
+				std::vector<SessionPtr> mySessions;
+				{
+					SPL::AutoMutex autoMutex(sessionsMutex);
+					for (const auto & entry : sessions)
+						mySessions.push_back(entry.second);
+				}
+				SPLAPPTRC(L_INFO, traceIntro <<
+					"-->Client is closing " << mySessions.size() << " Websocket connections to the Watson STT service.",
+					"prepareToShutdown");
+				for (const auto & s : mySessions) {
+					SPL::AutoMutex autoMutex(s->mutex);
+					if ( ! s->wsHandle.expired()) {
+						websocketpp::lib::error_code ec;
+						wsClient->close(s->wsHandle, websocketpp::close::status::internal_endpoint_error, "Shutdown", ec);
+					}
+				}
+				// let the io loop return when the last connection has finished
+				wsClient->stop_perpetual();
+			}
+		} catch (const std::exception& e) {
+			SPLAPPTRC(L_ERROR, traceIntro <<
+				"-->Exception during closing. " << e.what(),
+				"prepareToShutdown");
+		}
+		return;
+	}
 	// Close the Websocket connection to the Watson STT service.
 	// wsClient->get_alog().write(websocketpp::log::alevel::app, "Client is closing the Websocket connection to the Watson STT service.");
 	try {
@@ -338,12 +628,17 @@ void WatsonSTTImplReceiver<OP, OT>::prepareToShutdown() {
 			SPLAPPTRC(L_INFO, traceIntro <<
 				"-->Client is trying to close the Websocket connection to the Watson STT service.",
 				"prepareToShutdown");
-			if ( ! wsHandle.expired()) {
+			SessionPtr s = getMainSession();
+			SPL::AutoMutex autoMutex(s->mutex);
+			if ( ! s->wsHandle.expired()) {
 				SPLAPPTRC(L_INFO, traceIntro <<
 					"-->Client is closing the Websocket connection to the Watson STT service.",
 					"prepareToShutdown");
-				wsClient->close(wsHandle, websocketpp::close::status::internal_endpoint_error, "Shutdown");
+				websocketpp::lib::error_code ec;
+				wsClient->close(s->wsHandle, websocketpp::close::status::internal_endpoint_error, "Shutdown", ec);
 			}
+			// let the io loop return when the connection has finished
+			wsClient->stop_perpetual();
 		} else {
 			SPLAPPTRC(L_INFO, traceIntro <<
 				"-->Client is null.",
@@ -359,149 +654,559 @@ void WatsonSTTImplReceiver<OP, OT>::prepareToShutdown() {
 template<typename OP, typename OT>
 void WatsonSTTImplReceiver<OP, OT>::process(uint32_t idx) {
 	SPLAPPTRC(L_INFO, traceIntro << "-->Run thread idx=" << idx, "ws_receiver");
-	// run the operator receiver thread
-	ws_init();
+	if (idx == 0)
+		// run the operator receiver thread
+		ws_run();
+	else
+		// run the phrase dictionary thread
+		phraseDictionary_run();
 }
 
-// This method initializes the Websocket driver, TLS and then
-// opens a connection. This is going to run on its own thread.
 template<typename OP, typename OT>
-void WatsonSTTImplReceiver<OP, OT>::ws_init() {
-
+void WatsonSTTImplReceiver<OP, OT>::phraseDictionary_run() {
 	while (not splOperator.getPE().getShutdownRequested()) {
-		if (wsState.load() != WsState::start) {
-			// Keep waiting in this while loop until
-			// a need arises to make a new Websocket connection.
-			//SPLAPPTRC(L_TRACE, traceIntro << "-->RE0: wsState=" << wsStateToString(wsState.load()) <<
-			//		" No connection request in thread ws_init, block for " <<
-			//		receiverWaitTimeWhenIdle << " second", "ws_receiver");
-			SPL::Functions::Utility::block(receiverWaitTimeWhenIdle);
-			continue;
-		}
-		// here we are in state WsState::start
-		setWsState(WsState::connecting);
-		oTupleUsedForSubmission = nullptr;
-
-		// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-websockets#WSopen
-		std::string uri = this->uri;
-		// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-input#models
-		uri += "?model=" + baseLanguageModel;
-		// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-input#logging
-		uri += "&x-watson-learning-opt-out=" + std::string(sttRequestLogging ? "false" : "true");
-
-		// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-input#version
-		if (baseModelVersion != "") {
-			uri += "&base_model_version=" + baseModelVersion;
+		// prepareToShutdown notifies the state change
+		waitForStateChange(phraseDictionaryReloadPeriod, [this]() { return splOperator.getPE().getShutdownRequested(); });
+		if (splOperator.getPE().getShutdownRequested())
+			break;
+		try {
+			loadPhraseDictionary();
+		} catch (const std::exception & e) {
+			// keep the previous dictionary
+			SPLAPPTRC(L_ERROR, traceIntro << "-->RE61 phrase dictionary reload failed: " << e.what(), "ws_receiver");
 		}
+	}
+}
 
-		// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-input#custom
-		// At a time, only one LM customization can be specified.
-		// LM custom model chaining is not available as of Aug/2018.
-		if (customizationId != "") {
-			uri += "&customization_id=" + customizationId;
-		}
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::loadPhraseDictionary() {
+	const auto start = std::chrono::steady_clock::now();
+	PhraseDictionary::MatcherPtr newMatcher = phraseDictionary.loadIfChanged();
+	if ( ! newMatcher)
+		return;
+	const SPL::int64 phrases = static_cast<SPL::int64>(newMatcher->size());
+	std::atomic_store(&phraseMatcher, newMatcher);
+	++nPhraseDictionaryReloads;
+	nPhrasesInDictionaryMetric->setValueNoLock(phrases);
+	nPhraseDictionaryReloadsMetric->setValueNoLock(nPhraseDictionaryReloads);
+	SPLAPPTRC(L_INFO, traceIntro << "-->RE62 phrase dictionary loaded with " << phrases << " phrases in " <<
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms", "ws_receiver");
+}
 
-		if (acousticCustomizationId != "") {
-			uri += "&acoustic_customization_id=" + acousticCustomizationId;
-		}
+template<typename OP, typename OT>
+PhraseDictionary::MatcherPtr WatsonSTTImplReceiver<OP, OT>::spotPhrases(Session & s) {
+	PhraseDictionary::MatcherPtr myPhraseMatcher = std::atomic_load(&phraseMatcher);
+	phraseHits.clear();
+	if (myPhraseMatcher) {
+		myPhraseMatcher->match(
+				s.dec.DecoderAlternatives::getUtteranceWords(),
+				s.dec.DecoderAlternatives::getUtteranceWordsStartTimes(),
+				s.dec.DecoderAlternatives::getUtteranceWordsEndTimes(),
+				s.dec.DecoderAlternatives::getUtteranceWordsConfidences(),
+				s.dec.DecoderAlternatives::getConfidence(),
+				phraseHits,
+				phraseWordBuffer);
+	}
+	return myPhraseMatcher;
+}
 
-		uri += "&access_token=" + accessToken;
-		//wsConnectionEstablished = false;
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::initClient() {
+	wsClient = new client();
+	if ( ! wsClient)
+		throw std::bad_alloc();
+
+	// https://docs.websocketpp.org/reference_8logging.html
+	// Set the logging policy as needed
+	// Turn off or turn on selectively all the Websocket++ access interface and
+	// error interface logging channels. Do this based on how the user has
+	// configured this operator.
+	if (websocketLoggingNeeded == true) {
+		// Enable certain error logging channels and certain access logging channels.
+		wsClient->set_access_channels(websocketpp::log::alevel::frame_header);
+		wsClient->set_access_channels(websocketpp::log::alevel::frame_payload);
+	} else {
+		// Turn off both the access and error logging channels completely.
+		wsClient->clear_access_channels(websocketpp::log::alevel::all);
+		wsClient->clear_error_channels(websocketpp::log::elevel::all);
+	}
 
-		if (wsClient) {
-			// If we are going to do a reconnection, then free the
-			// previously created Websocket client object.
-			SPLAPPTRC(L_DEBUG, traceIntro << "-->RE1: Delete client " << uri, "ws_receiver");
-			delete wsClient;
-			wsClient = nullptr;
-		}
+	// Initialize ASIO
+	wsClient->init_asio();
 
-		try {
-			SPLAPPTRC(L_INFO, traceIntro << "-->RE2: Going to connect to " << uri, "ws_receiver");
-
-			wsClient = new client();
-			if ( ! wsClient)
-				throw std::bad_alloc();
-
-			// https://docs.websocketpp.org/reference_8logging.html
-			// Set the logging policy as needed
-			// Turn off or turn on selectively all the Websocket++ access interface and
-			// error interface logging channels. Do this based on how the user has
-			// configured this operator.
-			if (websocketLoggingNeeded == true) {
-				// Enable certain error logging channels and certain access logging channels.
-				wsClient->set_access_channels(websocketpp::log::alevel::frame_header);
-				wsClient->set_access_channels(websocketpp::log::alevel::frame_payload);
-			} else {
-				// Turn off both the access and error logging channels completely.
-				wsClient->clear_access_channels(websocketpp::log::alevel::all);
-				wsClient->clear_error_channels(websocketpp::log::elevel::all);
-			}
+	// IBM Watson STT service requires SSL based communication.
+	// Set this TLS handler.
+	// This technique to pass a class member method as a callback function is from here:
+	// https://stackoverflow.com/questions/34757245/websocketpp-callback-class-method-via-function-pointer
+	wsClient->set_tls_init_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_tls_init,this,wsClient,std::placeholders::_1));
+	wsClient->set_socket_init_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_socket_init,this,std::placeholders::_1,std::placeholders::_2));
+}
+
+template<typename OP, typename OT>
+std::string WatsonSTTImplReceiver<OP, OT>::getConnectionUri(const std::string & accessToken_) const {
+	// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-websockets#WSopen
+	std::string uri = this->uri;
+	// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-input#models
+	uri += "?model=" + baseLanguageModel;
+	// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-input#logging
+	uri += "&x-watson-learning-opt-out=" + std::string(sttRequestLogging ? "false" : "true");
+
+	// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-input#version
+	if (baseModelVersion != "") {
+		uri += "&base_model_version=" + baseModelVersion;
+	}
+
+	// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-input#custom
+	// At a time, only one LM customization can be specified.
+	// LM custom model chaining is not available as of Aug/2018.
+	if (customizationId != "") {
+		uri += "&customization_id=" + customizationId;
+	}
+
+	if (acousticCustomizationId != "") {
+		uri += "&acoustic_customization_id=" + acousticCustomizationId;
+	}
+
+	uri += "&access_token=" + accessToken_;
+	return uri;
+}
 
-			// Initialize ASIO
-			wsClient->init_asio();
-
-			// IBM Watson STT service requires SSL based communication.
-			// Set this TLS handler.
-			// This technique to pass a class member method as a callback function is from here:
-			// https://stackoverflow.com/questions/34757245/websocketpp-callback-class-method-via-function-pointer
-			wsClient->set_tls_init_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_tls_init,this,wsClient,std::placeholders::_1));
-
-			// Register our other event handlers.
-			wsClient->set_open_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_open,this,wsClient,std::placeholders::_1));
-			wsClient->set_fail_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_fail,this,wsClient,std::placeholders::_1));
-			wsClient->set_message_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_message,this,wsClient,std::placeholders::_1,std::placeholders::_2));
-			wsClient->set_close_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_close,this,wsClient,std::placeholders::_1));
-			//wsClient->set_ping_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_ping,this,wsClient,::_1,::_2));
-			//wsClient->set_pong_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_pong,this,wsClient,::_1,::_2));
-
-			// Create a connection to the given URI and queue it for connection once
-			// the event loop starts
-			SPLAPPTRC(L_DEBUG, traceIntro << "-->RE3 (after call back setup)", "ws_receiver");
-			websocketpp::lib::error_code ec;
-			// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-basic-request#using-the-websocket-interface
-			client::connection_ptr con = wsClient->get_connection(uri, ec);
-			SPLAPPTRC(L_DEBUG, traceIntro << "-->RE4 (after get_connection) ec=" << ec, "ws_receiver");
-			if (ec)
-				throw ec;
-
-			wsClient->connect(con);
-			// A new Websocket connection has just been made. Reset this flag.
-			SPLAPPTRC(L_DEBUG, traceIntro << "-->RE5 (after connect)", "ws_receiver");
-
-			// Start the ASIO io_service run loop
+// The receiver thread runs the io loop of the client.
+// The connections are triggered from the sender thread with requestConnection.
+// The io loop returns when stop_perpetual was called in prepareToShutdown and all connections have finished
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::ws_run() {
+	bool runReturned = false;
+	while (not runReturned) {
+		try {
+			SPLAPPTRC(L_INFO, traceIntro << "-->RE3 Start io loop", "ws_receiver");
 			wsClient->run();
+			runReturned = true;
 			SPLAPPTRC(L_INFO, traceIntro << "-->RE10 (after run)", "ws_receiver");
+		// An exception from one of the handlers must not stop the client
+		// The io loop may be continued after an exception
 		} catch (const std::exception & e) {
 			SPLAPPTRC(L_ERROR, traceIntro << "-->RE91 " << typeid(e).name() << ": "<< e.what(), "ws_receiver");
-			setWsState(WsState::crashed);
-			//SPL::Functions::Utility::abort(__FILE__, __LINE__);
+			abortMainConnection();
 		} catch (const websocketpp::lib::error_code & e) {
 			//websocketpp::lib::error_code is a class -> catching by reference makes sense
 			SPLAPPTRC(L_ERROR, traceIntro << "-->RE92 websocketpp::lib::error_code: e=" << e <<
 					" message=" << e.message(), "ws_receiver");
-			setWsState(WsState::crashed);
-			//SPL::Functions::Utility::abort(__FILE__, __LINE__);
+			abortMainConnection();
 		} catch (...) {
-			SPLAPPTRC(L_ERROR, traceIntro << "-->RE93 Other exception in WatsonSTT operator's Websocket initializtion.", "ws_receiver");
-			setWsState(WsState::crashed);
-			//SPL::Functions::Utility::abort(__FILE__, __LINE__);
+			SPLAPPTRC(L_ERROR, traceIntro << "-->RE93 Other exception in WatsonSTT operator's Websocket io loop.", "ws_receiver");
+			abortMainConnection();
 		}
-		// finally delete recentOTuple
-		recentOTuple.store(nullptr);
-	} // End of while loop.
+		if (splOperator.getPE().getShutdownRequested())
+			runReturned = true;
+	}
 	SPLAPPTRC(L_INFO, traceIntro <<
-			"-->End of loop ws_init: getShutdownRequested()=" << splOperator.getPE().getShutdownRequested(),
+			"-->End of loop ws_run: getShutdownRequested()=" << splOperator.getPE().getShutdownRequested(),
 			"ws_receiver");
-} // End: WatsonSTTImpl<OP, OT>::ws_init
+}
+
+// In single mode an exception in a handler terminates the ongoing connection
+// The close event drives the session into state closed and the sender makes a new connection attempt
+// If the connection can not be closed, the session is flagged as crashed
+// In multiplexed mode there is no main session: the message handler of each session catches its exceptions
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::abortMainConnection() {
+	if (multiplexed)
+		return;
+	SessionPtr mySession = getMainSession();
+	Session & s = *mySession;
+	websocketpp::lib::error_code ec;
+	wsClient->close(s.wsHandle, websocketpp::close::status::internal_endpoint_error, "Exception", ec);
+	if (ec) {
+		SPLAPPTRC(L_ERROR, traceIntro << "-->RE90 Can not close connection after exception: " << ec.message(), "ws_receiver");
+		// invalidate the handle; events of this connection are ignored
+		s.wsHandle.reset();
+		s.recentOTuple.store(nullptr);
+		setWsState(s, WsState::crashed);
+	}
+}
+
+// In multiplexed mode the io loop serves all conversations. An exception in the handler of a session
+// must not escape to ws_run: the error tuple of the conversation is sent and its connection is closed.
+// The close event sends the transcription completed tuple and removes the session.
+// If the connection can not be closed, this is done here
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::abortSessionConnection(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl,
+		const std::string & reason) {
+	sendErrorTuple(*s, reason);
+	setWsState(*s, WsState::error);
+	websocketpp::lib::error_code ec;
+	c->close(hdl, websocketpp::close::status::internal_endpoint_error, "Exception", ec);
+	if (ec) {
+		SPLAPPTRC(L_ERROR, traceIntro << "-->RE90m Can not close connection of conversation " << s->conversationId <<
+				" after exception: " << ec.message(), "ws_receiver");
+		{
+			// invalidate the handle; events of this connection are ignored
+			SPL::AutoMutex autoMutex(s->mutex);
+			s->wsHandle.reset();
+		}
+		OT * myRecentOTuple = loadResultOTuple(*s);
+		if (myRecentOTuple && Config::isTranscriptionCompletedRequested)
+			sendTranscriptionCompletedTuple(myRecentOTuple);
+		s->recentOTuple.store(nullptr);
+		setWsState(*s, WsState::failed);
+		finishSession(s);
+	}
+}
+
+template<typename OP, typename OT>
+typename WatsonSTTImplReceiver<OP, OT>::SessionPtr WatsonSTTImplReceiver<OP, OT>::findSession(const std::string & conversationId) {
+	SPL::AutoMutex autoMutex(sessionsMutex);
+	auto it = sessions.find(conversationId);
+	if (it == sessions.end())
+		return SessionPtr();
+	return it->second;
+}
+
+template<typename OP, typename OT>
+typename WatsonSTTImplReceiver<OP, OT>::SessionPtr WatsonSTTImplReceiver<OP, OT>::getMainSession() {
+	SPL::AutoMutex autoMutex(sessionsMutex);
+	return mainSession;
+}
+
+template<typename OP, typename OT>
+typename WatsonSTTImplReceiver<OP, OT>::SessionPtr WatsonSTTImplReceiver<OP, OT>::takeStandbySession(const std::string & conversationId) {
+	if (standbyConnections <= 0)
+		return SessionPtr();
+	SessionPtr result;
+	{
+		SPL::AutoMutex autoMutex(sessionsMutex);
+		// visit each session in the pool at most once
+		for (size_t n = standbySessions.size(); (n > 0) && ! result; --n) {
+			SessionPtr s = standbySessions.front();
+			standbySessions.pop_front();
+			SPL::AutoMutex sessionAutoMutex(s->mutex);
+			// a session which is not listening is either connecting or has been closed by the service
+			// a connecting session is put back to the end of the pool; a closed session is dropped
+			WsState st = s->wsState.load();
+			if (st == WsState::listening) {
+				s->inStandby.store(false);
+				s->conversationId = conversationId;
+				result = s;
+			} else if (receiverHasTransientState(st) && (st != WsState::closing)) {
+				standbySessions.push_back(s);
+			}
+		}
+	}
+	// open a replacement
+	wsClient->get_io_service().post(bind(&WatsonSTTImplReceiver<OP, OT>::replenishStandby, this));
+	if (result) {
+		SPLAPPTRC(L_DEBUG, traceIntro << "-->RE2s Take standby session for conversation " << conversationId, "ws_sender");
+	}
+	return result;
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::setStandbyAccessToken(const std::string & accessToken_) {
+	if (standbyConnections <= 0)
+		return;
+	{
+		SPL::AutoMutex autoMutex(sessionsMutex);
+		standbyAccessToken = accessToken_;
+	}
+	wsClient->get_io_service().post(bind(&WatsonSTTImplReceiver<OP, OT>::replenishStandby, this));
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::replenishStandby() {
+	if (splOperator.getPE().getShutdownRequested())
+		return;
+	const auto now = std::chrono::steady_clock::now();
+	const auto maxAge = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<SPL::float64>(standbyRefreshPeriod));
+	std::vector<SessionPtr> retired;
+	std::vector<SessionPtr> created;
+	SPL::int64 nListening = 0;
+	{
+		SPL::AutoMutex autoMutex(sessionsMutex);
+		// remove the sessions which have stopped or have reached the refresh period
+		// the service closes idle connections and the access token of a connection may expire
+		for (auto it = standbySessions.begin(); it != standbySessions.end(); ) {
+			SessionPtr s = *it;
+			WsState st = s->wsState.load();
+			if (receiverHasStopped(st) || (st == WsState::error)) {
+				it = standbySessions.erase(it);
+			} else if (now - s->standbySince > maxAge) {
+				retired.push_back(s);
+				it = standbySessions.erase(it);
+			} else {
+				if (st == WsState::listening)
+					++nListening;
+				++it;
+			}
+		}
+		if ( ! standbyAccessToken.empty()) {
+			while (standbySessions.size() < static_cast<size_t>(standbyConnections)) {
+				SessionPtr s = std::make_shared<Session>(*this, std::string());
+				s->accessToken = standbyAccessToken;
+				s->inStandby.store(true);
+				s->standbySince = now;
+				standbySessions.push_back(s);
+				created.push_back(s);
+			}
+		}
+	}
+	nStandbyConnectionsMetric->setValueNoLock(nListening);
+	for (const auto & s : retired)
+		retireStandbySession(s);
+	for (const auto & s : created) {
+		setWsState(*s, WsState::start);
+		connectSession(s);
+	}
+	if (standbyTimer) {
+		standbyTimer->expires_from_now(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<SPL::float64>(standbyCheckPeriod)));
+		standbyTimer->async_wait(bind(&WatsonSTTImplReceiver<OP, OT>::on_standby_timer, this, std::placeholders::_1));
+	}
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::on_standby_timer(const boost::system::error_code & ec) {
+	if (ec == boost::asio::error::operation_aborted)
+		return;
+	replenishStandby();
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::retireStandbySession(const SessionPtr & s) {
+	SPL::AutoMutex autoMutex(s->mutex);
+	if (s->inStandby && ! s->wsHandle.expired()) {
+		SPLAPPTRC(L_DEBUG, traceIntro << "-->RE96 Close standby session", "ws_receiver");
+		setWsState(*s, WsState::closing);
+		websocketpp::lib::error_code ec;
+		wsClient->close(s->wsHandle, websocketpp::close::status::going_away, "", ec);
+	}
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::stopStandby() {
+	if (standbyTimer)
+		standbyTimer->cancel();
+	std::deque<SessionPtr> mySessions;
+	{
+		SPL::AutoMutex autoMutex(sessionsMutex);
+		mySessions.swap(standbySessions);
+	}
+	for (const auto & s : mySessions)
+		retireStandbySession(s);
+	nStandbyConnectionsMetric->setValueNoLock(0);
+}
+
+template<typename OP, typename OT>
+typename WatsonSTTImplReceiver<OP, OT>::SessionPtr WatsonSTTImplReceiver<OP, OT>::openSession(
+		const std::string & conversationId, const std::string & accessToken_, const OT & otuple) {
+	SessionPtr s = takeStandbySession(conversationId);
+	bool connected = static_cast<bool>(s);
+	if ( ! connected) {
+		s = std::make_shared<Session>(*this, conversationId);
+		s->accessToken = accessToken_;
+	}
+	{
+		// a standby session may be closed concurrently in the receiver thread
+		SPL::AutoMutex autoMutex(s->mutex);
+		s->conversationOTuple = otuple;
+		s->recentOTuple.store(&s->conversationOTuple);
+	}
+	s->transcriptionFinalized.store(false);
+	if ( ! connected)
+		setWsState(*s, WsState::start);
+	{
+		SPL::AutoMutex autoMutex(sessionsMutex);
+		sessions[conversationId] = s;
+	}
+	++nActiveConversations;
+	nActiveConversationsMetric->setValueNoLock(nActiveConversations);
+	SPLAPPTRC(L_DEBUG, traceIntro << "-->RE2m Open session for conversation " << conversationId <<
+			" standby=" << connected, "ws_sender");
+	if ( ! connected)
+		requestConnection(s);
+	return s;
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::requestConnection(const SessionPtr & s) {
+	// the connection is made in the receiver thread
+	wsClient->get_io_service().post(bind(&WatsonSTTImplReceiver<OP, OT>::connectSession, this, s));
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::connectSession(SessionPtr s) {
+	setWsState(*s, WsState::connecting);
+	s->oTupleUsedForSubmission = nullptr;
+	SPLAPPTRC(L_INFO, traceIntro << "-->RE2 Going to connect conversation " << s->conversationId, "ws_receiver");
+	websocketpp::lib::error_code ec;
+	// https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-basic-request#using-the-websocket-interface
+	client::connection_ptr con = wsClient->get_connection(getConnectionUri(s->accessToken), ec);
+	SPLAPPTRC(L_DEBUG, traceIntro << "-->RE4 (after get_connection) ec=" << ec, "ws_receiver");
+	if (ec) {
+		std::stringstream errmess;
+		errmess << traceIntro << "-->RE94 Connection to the Watson STT service failed for conversation " <<
+				s->conversationId << " ec.value=" << ec.value() << " ec.message=" << ec.message();
+		SPLAPPTRC(L_ERROR, errmess.str(), "ws_receiver");
+		if (s->inStandby.load()) {
+			// the standby session is dropped from the pool in replenishStandby
+			setWsState(*s, WsState::failed);
+		} else if (multiplexed) {
+			sendErrorTuple(*s, errmess.str());
+			s->recentOTuple.store(nullptr);
+			setWsState(*s, WsState::failed);
+			finishSession(s);
+		} else {
+			// the sender thread makes a new connection attempt
+			s->recentOTuple.store(nullptr);
+			setWsState(*s, WsState::crashed);
+		}
+		return;
+	}
+	{
+		// Store this handle to be used from process and shutdown methods of this operator.
+		// in multiplexed mode the sender thread reads the handle concurrently
+		SPL::AutoMutex autoMutex(s->mutex);
+		s->wsHandle = con->get_handle();
+	}
+
+	// Register our event handlers at the connection
+	con->set_open_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_open,this,wsClient,s,std::placeholders::_1));
+	con->set_fail_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_fail,this,wsClient,s,std::placeholders::_1));
+	if (multiplexed)
+		con->set_message_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_session_message,this,wsClient,s,std::placeholders::_1,std::placeholders::_2));
+	else
+		con->set_message_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_message,this,wsClient,s,std::placeholders::_1,std::placeholders::_2));
+	con->set_close_handler(bind(&WatsonSTTImplReceiver<OP, OT>::on_close,this,wsClient,s,std::placeholders::_1));
+
+	wsClient->connect(con);
+	SPLAPPTRC(L_DEBUG, traceIntro << "-->RE5 (after connect)", "ws_receiver");
+}
+
+template<typename OP, typename OT>
+bool WatsonSTTImplReceiver<OP, OT>::isCurrentConnection(Session & s, websocketpp::connection_hdl hdl) {
+	SPL::AutoMutex autoMutex(s.mutex);
+	return not s.wsHandle.owner_before(hdl) && not hdl.owner_before(s.wsHandle);
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::finishSession(const SessionPtr & s) {
+	{
+		SPL::AutoMutex autoMutex(sessionsMutex);
+		auto it = sessions.find(s->conversationId);
+		// the sender may have replaced the entry with the session of a subsequent conversation
+		if ((it != sessions.end()) && (it->second == s))
+			sessions.erase(it);
+	}
+	--nActiveConversations;
+	nActiveConversationsMetric->setValueNoLock(nActiveConversations);
+	notifyStateChange();
+	SPLAPPTRC(L_DEBUG, traceIntro << "-->RE95 Session finished for conversation " << s->conversationId <<
+			" wsState=" << wsStateToString(s->wsState.load()), "ws_receiver");
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::sendAudio(websocketpp::connection_hdl hdl, unsigned char const * audioBytes,
+		uint64_t audioSize, MappedAudioFile * mapping, AudioPacer & pacer, AudioSendTimeline & timeline,
+		websocketpp::lib::error_code & ec) {
+
+	client::connection_ptr con = wsClient->get_con_from_hdl(hdl, ec);
+	if (ec)
+		return;
+	// a chunk size of 0 sends the audio in one frame
+	const uint64_t chunkSize = (audioChunkSize > 0) ? static_cast<uint64_t>(audioChunkSize) : audioSize;
+	const size_t maxBuffered = chunkSize * maxBufferedAudioChunks;
+	uint64_t sent = 0;
+	while (sent < audioSize) {
+		// back-pressure: the connection sends the queued frames in the receiver thread
+		while ((not multiplexed) && (con->get_buffered_amount() > maxBuffered) &&
+				(con->get_state() == websocketpp::session::state::open)) {
+			if (splOperator.getPE().getShutdownRequested())
+				return;
+			SPL::Functions::Utility::block(senderWaitTimeForSendQueue);
+		}
+		uint64_t len = std::min(chunkSize, audioSize - sent);
+		if (pacedAudioByteRate > 0.0) {
+			// pacing: wait until the chunk is due
+			const AudioPacer::Clock::time_point due = pacer.schedule(len, pacedAudioByteRate, maxPacingLag);
+			AudioPacer::Clock::time_point now = AudioPacer::Clock::now();
+			while (now < due) {
+				SPL::float64 waitTime = std::chrono::duration<SPL::float64>(due - now).count();
+				if (waitForStateChange(waitTime, [this]() { return splOperator.getPE().getShutdownRequested(); }))
+					return;
+				now = AudioPacer::Clock::now();
+			}
+		}
+		// the frame is masked in a copy of the data; the chunk is not accessed after send returns
+		ec = con->send(audioBytes + sent, len, websocketpp::frame::opcode::binary);
+		if (ec)
+			return;
+		if (utteranceLatencyNeeded)
+			timeline.record(len, AudioSendTimeline::Clock::now());
+		sent = sent + len;
+		if (mapping)
+			mapping->release(sent);
+	}
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::sendSessionAudio(Session & s, unsigned char const * audioBytes, uint64_t audioSize,
+		MappedAudioFile * mapping) {
+	if (audioSize == 0)
+		return;
+	websocketpp::connection_hdl hdl;
+	{
+		SPL::AutoMutex autoMutex(s.mutex);
+		WsState myWsState = s.wsState.load();
+		if (myWsState == WsState::listening) {
+			// the audio is sent without the session mutex: the receiver thread may need it to proceed
+			hdl = s.wsHandle;
+		} else if (receiverHasStopped(myWsState) || (myWsState == WsState::error)) {
+			SPLAPPTRC(L_ERROR, traceIntro << "-->CS12 Drop audio of conversation " << s.conversationId <<
+					" wsState=" << wsStateToString(myWsState), "ws_sender");
+			return;
+		} else {
+			// the session is not yet listening; the audio is sent in on_message when state listening is reached
+			s.pendingAudio.insert(s.pendingAudio.end(), audioBytes, audioBytes + audioSize);
+			return;
+		}
+	}
+	websocketpp::lib::error_code ec;
+	sendAudio(hdl, audioBytes, audioSize, mapping, s.pacer, s.sendTimeline, ec);
+	if (ec) {
+		SPLAPPTRC(L_ERROR, traceIntro << "-->CS9 Error when send audio of conversation " << s.conversationId <<
+				" ec=" << ec << " message=" << ec.message(), "ws_sender");
+	}
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::stopSession(const SessionPtr & s) {
+	{
+		SPL::AutoMutex autoMutex(sessionsMutex);
+		auto it = sessions.find(s->conversationId);
+		if ((it != sessions.end()) && (it->second == s))
+			sessions.erase(it);
+	}
+	SPL::AutoMutex autoMutex(s->mutex);
+	s->stopRequested = true;
+	if (s->wsState.load() == WsState::listening) {
+		SPLAPPTRC(L_INFO, traceIntro << "-->CS6 Send \"action\" : \"stop\" conversation " << s->conversationId, "ws_sender");
+		websocketpp::lib::error_code ec;
+		wsClient->send(s->wsHandle, "{\"action\" : \"stop\"}", websocketpp::frame::opcode::text, ec);
+		if (ec) {
+			SPLAPPTRC(L_ERROR, traceIntro << "-->CS10 Error in stopSession ec=" << ec <<
+					" message=" << ec.message(), "ws_sender");
+		}
+	}
+}
 
 // When the Websocket connection to the Watson STT service is made successfully,
 // this callback method will be called from the websocketpp layer.
 // Either open or fail will be called for each connection. Never both.
 template<typename OP, typename OT>
-void WatsonSTTImplReceiver<OP, OT>::on_open(client* c, websocketpp::connection_hdl hdl) {
+void WatsonSTTImplReceiver<OP, OT>::on_open(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl) {
 
-	setWsState(WsState::open);
+	setWsState(*s, WsState::open);
 
 	SPLAPPTRC(L_DEBUG, traceIntro << "-->RE6 (on_open)", "ws_receiver");
 	// On Websocket connection open, establish a session with the STT service.
@@ -618,8 +1323,13 @@ void WatsonSTTImplReceiver<OP, OT>::on_open(client* c, websocketpp::connection_h
 	msg += std::string("}");
 
 	c->send(hdl,msg,websocketpp::frame::opcode::text);
-	// Store this handle to be used from process and shutdown methods of this operator.
-	wsHandle = hdl;
+	// keep the TLS session for the resumption in subsequent connections
+	SSL_SESSION * newSslSession = SSL_get1_session(c->get_con_from_hdl(hdl)->get_socket().native_handle());
+	if (newSslSession) {
+		if (sslSession)
+			SSL_SESSION_free(sslSession);
+		sslSession = newSslSession;
+	}
 	// c->get_alog().write(websocketpp::log::alevel::app, "Sent Message: "+msg);
 	SPLAPPTRC(L_INFO, traceIntro <<
 			"-->RE7 A recognition request start message was sent to the Watson STT service at host:" <<
@@ -630,7 +1340,7 @@ void WatsonSTTImplReceiver<OP, OT>::on_open(client* c, websocketpp::connection_h
 // received from the STT service, this callback method will be called from the websocketpp layer.
 // https://cloud.ibm.com/docs/services/speech-to-text?topic=speech-to-text-websockets#WSexample
 template<typename OP, typename OT>
-void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connection_hdl hdl, message_ptr msg) {
+void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl, message_ptr msg) {
 
 	// c->get_alog().write(websocketpp::log::alevel::app, "Received Reply: "+msg->get_payload());
 	//
@@ -650,7 +1360,7 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 	// develop and fine-tune the JSON message parsing logic.
 
 	// Entry state check
-	WsState entryState = wsState.load();
+	WsState entryState = s->wsState.load();
 	SPLAPPTRC(L_DEBUG, traceIntro << "-->on_message entyState: " << wsStateToString(entryState), "ws_receiver");
 	if ((entryState != WsState::open) && (entryState != WsState::listening))
 		throw std::runtime_error(traceIntro + "-->RE80 Unexpected entryState in ws on_message; state: " + std::string(wsStateToString(entryState)));
@@ -662,7 +1372,7 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 	const std::string & payload_ = msg->get_payload();
 	bool completeResults = Config::sttOutputResultMode == Config::complete;
 	SPLAPPTRC(L_TRACE, traceIntro << "-->RE7 on_message payload_: " << payload_, "ws_receiver");
-	dec.doWork(payload_);
+	s->dec.doWork(payload_);
 
 	// STT error will have the following message format.
 	// {"error": "unable to transcode data stream audio/wav -> audio/x-float-array "}
@@ -672,12 +1382,12 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 	// we expect either a state, error, result or a speaker message
 	// a resultIndex must come along with a result
 	// a state message must always be 'listening'
-	const bool stateFound_           = dec.DecoderState::hasResult();
-	const bool stateListeningFound_  = dec.isListening();
-	const bool sttErrorFound_        = dec.DecoderError::hasResult();
-	const bool utteranceResultFound_ = dec.DecoderResults::hasResult();
-	const bool speakerResultFound_   = dec.DecoderSpeakerLabels::hasResult();
-	const bool resultIndexFound_     = dec.DecoderResultIndex::hasResult();
+	const bool stateFound_           = s->dec.DecoderState::hasResult();
+	const bool stateListeningFound_  = s->dec.isListening();
+	const bool sttErrorFound_        = s->dec.DecoderError::hasResult();
+	const bool utteranceResultFound_ = s->dec.DecoderResults::hasResult();
+	const bool speakerResultFound_   = s->dec.DecoderSpeakerLabels::hasResult();
+	const bool resultIndexFound_     = s->dec.DecoderResultIndex::hasResult();
 	// Check the input expectations
 	int numFound = 0;
 	if (stateFound_)
@@ -717,7 +1427,29 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 				"-->RE20 state listening reached. Websocket connection established with the Watson STT service.",
 				"ws_receiver");
 
-			setWsState(WsState::listening);
+			if (multiplexed) {
+				// flush the audio which was received before the session was listening
+				// and send the stop action if the end of the conversation was already received
+				SPL::AutoMutex autoMutex(s->mutex);
+				setWsState(*s, WsState::listening);
+				websocketpp::lib::error_code ec;
+				if ( ! s->pendingAudio.empty()) {
+					SPLAPPTRC(L_DEBUG, traceIntro << "-->RE21 send " << s->pendingAudio.size() <<
+							" queued audio bytes of conversation " << s->conversationId, "ws_receiver");
+					c->send(hdl, s->pendingAudio.data(), s->pendingAudio.size(), websocketpp::frame::opcode::binary, ec);
+					if ( ! ec && utteranceLatencyNeeded)
+						s->sendTimeline.record(s->pendingAudio.size(), AudioSendTimeline::Clock::now());
+					std::vector<unsigned char>().swap(s->pendingAudio);
+				}
+				if ( ! ec && s->stopRequested)
+					c->send(hdl, "{\"action\" : \"stop\"}", websocketpp::frame::opcode::text, ec);
+				if (ec) {
+					SPLAPPTRC(L_ERROR, traceIntro << "-->RE22 Error when send queued audio of conversation " <<
+							s->conversationId << " ec=" << ec << " message=" << ec.message(), "ws_receiver");
+				}
+			} else {
+				setWsState(*s, WsState::listening);
+			}
 			return;
 
 		} else { //state listening
@@ -733,12 +1465,12 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 			// Thus the stt service closes the connection after approx. 30 sec.
 			// This may produce is rare cases a race condition of the connection close from stt and the transmission of
 			// new speech samples. In this case a whole file may get lost.
-			if (nextConversationQueued.load()) {
+			if (s->nextConversationQueued.load()) {
 				SPLAPPTRC(L_DEBUG, traceIntro <<
 					"-->RE85 Transcription completion and nextConversationQueued - Keep connection", "ws_receiver");
 			} else {
-				setWsState(WsState::closing);
-				wsClient->close(hdl, websocketpp::close::status::going_away, "");
+				setWsState(*s, WsState::closing);
+				c->close(hdl, websocketpp::close::status::going_away, "");
 				SPLAPPTRC(L_DEBUG, traceIntro <<
 					"-->RE86 Transcription completion and no nextConversationQueued. Going to close", "ws_receiver");
 			}
@@ -749,10 +1481,16 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 	// Error
 	if (sttErrorFound_) {
 
-		std::string sttErrorString_ = dec.DecoderError::getResult();
+		std::string sttErrorString_ = s->dec.DecoderError::getResult();
+		if (s->inStandby.load()) {
+			// e.g. the session timeout of an idle standby connection; the pool drops the session
+			SPLAPPTRC(L_INFO, traceIntro << "-->RE25a STT error message in standby session=" << sttErrorString_, "ws_receiver");
+			setWsState(*s, WsState::error);
+			return;
+		}
 		SPLAPPTRC(L_ERROR, traceIntro << "-->RE25 STT error message=" << sttErrorString_, "ws_receiver");
-		sendErrorTuple(sttErrorString_);
-		setWsState(WsState::error);
+		sendErrorTuple(*s, sttErrorString_);
+		setWsState(*s, WsState::error);
 		return;
 
 	}
@@ -763,13 +1501,13 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 		incrementNFullAudioConversationsTranscribed();
 
 		// The conversation should end with a completed submission cycle (speaker labels and utterances are sent)
-		if (oTupleUsedForSubmission) {
+		if (s->oTupleUsedForSubmission) {
 			SPLAPPTRC(L_ERROR, traceIntro << "-->RE29 fullTranscriptionCompleted_ but non finalized oTupleUsedForSubmission available", "ws_receiver");
-			splOperator.submit(*oTupleUsedForSubmission, 0);
-			oTupleUsedForSubmission = nullptr;
+			splOperator.submit(*s->oTupleUsedForSubmission, 0);
+			s->oTupleUsedForSubmission = nullptr;
 		}
 		if (Config::isTranscriptionCompletedRequested) {
-			OT * myRecentOTuple = recentOTuple.load(); // load atomic
+			OT * myRecentOTuple = loadResultOTuple(*s);
 			// there should be a conversation which means recentOTuple must not be null
 			// log an error if not
 			if (myRecentOTuple) {
@@ -781,10 +1519,14 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 		SPLAPPTRC(L_DEBUG, traceIntro << "-->RE 30a send window punctuation marker.", "ws_receiver");
 		// delete the recentOTuple if end of conversation was reached
 		// flag transcriptionFinalized
-		recentOTuple.store(nullptr);
+		s->recentOTuple.store(nullptr);
 		// flag the conversation end in any case
-		splOperator.submit(SPL::Punctuation::WindowMarker, 0);
-		transcriptionFinalized.store(true);
+		// in multiplexed mode the conversations are interleaved and the end of a conversation is
+		// signaled with the transcription completed tuple only
+		if (not multiplexed)
+			splOperator.submit(SPL::Punctuation::WindowMarker, 0);
+		s->transcriptionFinalized.store(true);
+		notifyStateChange();
 
 		return;
 	}
@@ -792,60 +1534,73 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 	// utterance result(s) found
 	if (utteranceResultFound_) {
 
-		if (oTupleUsedForSubmission) {
+		if (s->oTupleUsedForSubmission) {
 			SPLAPPTRC(L_ERROR, traceIntro << "-->RE32 utteranceResultFound_ but non finalized oTupleUsedForSubmission available", "ws_receiver");
-			splOperator.submit(*oTupleUsedForSubmission, 0);
-			oTupleUsedForSubmission = nullptr;
+			splOperator.submit(*s->oTupleUsedForSubmission, 0);
+			s->oTupleUsedForSubmission = nullptr;
 		}
 
-		OT * myRecentOTuple = recentOTuple.load(); // load atomic
+		OT * myRecentOTuple = loadResultOTuple(*s);
 		if (myRecentOTuple) {
 			bool finalUtteranceOrModeComplete = false;
 			// if sttResultgMode is complete use a fixed value of true for value final
 			if (Config::sttOutputResultMode == WatsonSTTConfig::complete) {
 				finalUtteranceOrModeComplete = true;
 			} else {
-				if (dec.DecoderResults::getSize() > 1) {
+				if (s->dec.DecoderResults::getSize() > 1) {
 					SPLAPPTRC(L_ERROR, traceIntro << "-->RE33 more than one result received in partial mode", "ws_receiver");
 				}
-				if (dec.DecoderResults::getSize() == 0) {
+				if (s->dec.DecoderResults::getSize() == 0) {
 					SPLAPPTRC(L_ERROR, traceIntro << "-->RE34 zero results received in partial mode", "ws_receiver");
 				} else {
-					finalUtteranceOrModeComplete = dec.DecoderFinal::getResult(0);
+					finalUtteranceOrModeComplete = s->dec.DecoderFinal::getResult(0);
 				}
 			}
 			// prepare speaker label consistency check
 			if (Config::identifySpeakers) {
-				myUtteranceWordsStartTimes = dec.DecoderAlternatives::getUtteranceWordsStartTimes();
+				s->myUtteranceWordsStartTimes = s->dec.DecoderAlternatives::getUtteranceWordsStartTimes();
 			}
 			// clean speaker values which are probably set
 			if (Config::identifySpeakers)
-				splOperator.setSpeakerResultAttributes(myRecentOTuple, emptySpeakerResults);
+				splOperator.clearSpeakerResultAttributes(myRecentOTuple);
 			// prepare keywords
-			const KeywordProcessor keywordProc(dec.DecoderKeywordsResult::getKeywordsSpottingResults());
+			const KeywordProcessor keywordProc(s->dec);
+			// spot the phrases before the words are swapped into the output tuple
+			// the phrases are spotted in the final utterances only
+			PhraseDictionary::MatcherPtr myPhraseMatcher;
+			if (Config::phraseSpottingResultsNeeded && finalUtteranceOrModeComplete)
+				myPhraseMatcher = spotPhrases(*s);
+			const PhraseProcessor phraseProc(myPhraseMatcher.get(), phraseHits);
+			// the latency is measured for the final utterances only
+			SPL::float64 utteranceLatency = -1.0;
+			if (Config::utteranceLatencyNeeded && finalUtteranceOrModeComplete)
+				utteranceLatency = measureUtteranceLatency(*s, s->dec.DecoderAlternatives::getUtteranceEndTime());
 			// set utterance result attributes
+			// the result lists are swapped into the output tuple
 			splOperator.setResultAttributes(
 					myRecentOTuple,
-					dec.DecoderResultIndex::getResult(),
+					s->dec.DecoderResultIndex::getResult(),
 					finalUtteranceOrModeComplete,
 					// utterances
-					dec.DecoderAlternatives::getConfidence(),
-					dec.DecoderAlternatives::getUtteranceStartTime(),
-					dec.DecoderAlternatives::getUtteranceEndTime(),
-					dec.DecoderAlternatives::getUtteranceText(),
+					s->dec.DecoderAlternatives::getConfidence(),
+					s->dec.DecoderAlternatives::getUtteranceStartTime(),
+					s->dec.DecoderAlternatives::getUtteranceEndTime(),
+					utteranceLatency,
+					s->dec.DecoderAlternatives::releaseUtteranceText(),
 					// alternatives
-					dec.DecoderAlternatives::getUtteranceAlternatives(),
+					s->dec.DecoderAlternatives::releaseUtteranceAlternatives(),
 					// word alternatives
-					dec.DecoderAlternatives::getUtteranceWords(),
-					dec.DecoderAlternatives::getUtteranceWordsConfidences(),
-					dec.DecoderAlternatives::getUtteranceWordsStartTimes(),
-					dec.DecoderAlternatives::getUtteranceWordsEndTimes(),
+					s->dec.DecoderAlternatives::releaseUtteranceWords(),
+					s->dec.DecoderAlternatives::releaseUtteranceWordsConfidences(),
+					s->dec.DecoderAlternatives::releaseUtteranceWordsStartTimes(),
+					s->dec.DecoderAlternatives::releaseUtteranceWordsEndTimes(),
 					// confusion
-					dec.DecoderWordAlternatives::getWordAlternatives(),
-					dec.DecoderWordAlternatives::getWordAlternativesConfidences(),
-					dec.DecoderWordAlternatives::getWordAlternativesStartTimes(),
-					dec.DecoderWordAlternatives::getWordAlternativesEndTimes(),
-					keywordProc
+					s->dec.DecoderWordAlternatives::releaseWordAlternatives(),
+					s->dec.DecoderWordAlternatives::releaseWordAlternativesConfidences(),
+					s->dec.DecoderWordAlternatives::releaseWordAlternativesStartTimes(),
+					s->dec.DecoderWordAlternatives::releaseWordAlternativesEndTimes(),
+					keywordProc,
+					phraseProc
 			);
 
 			// output logic of the tuple
@@ -853,7 +1608,7 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 				// send or queue final utterances
 				if (Config::identifySpeakers) {
 					SPLAPPTRC(L_DEBUG, traceIntro << "-->RE35 queue utterance results until speaker labels are available", "ws_receiver");
-					oTupleUsedForSubmission = myRecentOTuple;
+					s->oTupleUsedForSubmission = myRecentOTuple;
 				} else {
 					SPLAPPTRC(L_DEBUG, traceIntro << "-->RE36a send utterance results tuple", "ws_receiver");
 					splOperator.submit(*myRecentOTuple, 0);
@@ -879,14 +1634,14 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 		if (not Config::identifySpeakers) {
 			SPLAPPTRC(L_WARN, traceIntro << "-->RE37 ignore speaker labels because they are not requested", "ws_receiver");
 		} else {
-			if (oTupleUsedForSubmission) {
+			if (s->oTupleUsedForSubmission) {
 				SPLAPPTRC(L_DEBUG, traceIntro << "-->RE38 send queued utterance results tuple with speaker info", "ws_receiver");
-				SpeakerProcessor spkproc(dec, myUtteranceWordsStartTimes, traceIntro, payload_);
+				SpeakerProcessor spkproc(s->dec, s->myUtteranceWordsStartTimes, traceIntro, payload_);
 				spkproc.run();
 				// assign speaker labels to output tuple
-				splOperator.setSpeakerResultAttributes(oTupleUsedForSubmission, spkproc);
-				splOperator.submit(*oTupleUsedForSubmission, 0);
-				oTupleUsedForSubmission = nullptr;
+				splOperator.setSpeakerResultAttributes(s->oTupleUsedForSubmission, spkproc);
+				splOperator.submit(*s->oTupleUsedForSubmission, 0);
+				s->oTupleUsedForSubmission = nullptr;
 			} else {
 				SPLAPPTRC(L_WARN, traceIntro << "-->RE39 ignore speaker info because no oTuple with utterances is available. payload_:" << payload_, "ws_receiver");
 			}
@@ -895,150 +1650,21 @@ void WatsonSTTImplReceiver<OP, OT>::on_message(client* c, websocketpp::connectio
 	}
 } // End of the on_message method.
 
-SpeakerProcessor::SpeakerProcessor(
-		const Decoder & dec_,
-		const SPL::list<SPL::float64> & myUtteranceWordsStartTimes_,
-		const std::string & traceIntro_,
-		const std::string & payload_) :
-	spkSize(dec_.DecoderSpeakerLabels::getSize()),
-	spkFrom(dec_.DecoderSpeakerLabels::getFrom()),
-	spkSpk(dec_.DecoderSpeakerLabels::getSpeaker()),
-	spkCfd(dec_.DecoderSpeakerLabels::getConfidence()),
-	wordListSize(myUtteranceWordsStartTimes_.size()),
-	myUtteranceWordsStartTimes(myUtteranceWordsStartTimes_),
-	traceIntro(traceIntro_),
-	payload(payload_),
-	spkFromNew(),
-	spkSpkNew(),
-	spkCfdNew(),
-	spkUpdateIndexes() {
-		spkFromNew.reserve(wordListSize);
-		spkSpkNew.reserve(wordListSize);
-		spkCfdNew.reserve(wordListSize);
-}
-
-SpeakerProcessor::SpeakerProcessor() :
-	spkSize(0),
-	// the references to the temporary lists are invalid but are never used in this instance in get...
-	// spkUpdateIndexes.size() is zero in this instance
-	spkFrom(SPL::list<SPL::float64>()),
-	spkSpk(SPL::list<SPL::int32>()),
-	spkCfd(SPL::list<SPL::float64>()),
-	wordListSize(0),
-	myUtteranceWordsStartTimes(SPL::list<SPL::float64>()),
-	traceIntro(""),
-	payload(""),
-	spkFromNew(),
-	spkSpkNew(),
-	spkCfdNew(),
-	spkUpdateIndexes() {
-}
-
-void SpeakerProcessor::run() {
-	// speaker consistency check - check the from time of the speaker labels against the from time of the words list
-	// this test guarantees that for each word in word list, a speaker label is correctly assigned
-	// if a speaker label is missing for a specific word from time, the value -1 is assigned
-	// speaker index map - key: skpFromTime value: speaker list index
-	std::unordered_map<SPL::float64, rapidjson::SizeType> spkIndexMap;
-	for (rapidjson::SizeType i = 0; i < spkSize; i++) {
-		spkIndexMap.insert(std::pair<const SPL::float64, rapidjson::SizeType>(spkFrom[i], i));
-	}
-	// size check
-	auto wordListSize = myUtteranceWordsStartTimes.size();
-	if (spkSize != wordListSize) {
-		SPLAPPTRC(L_DEBUG, traceIntro << "-->RE41 Word list size " << wordListSize <<
-				" and speaker list size " << spkSize << " are not equal.", "ws_receiver");
-	}
-	// the result lists - each entry corresponds to the entry in the word list
-	// a set with all indexes used from the word list
-	std::unordered_set<rapidjson::SizeType> usedSpkIndexes;
-	for (rapidjson::SizeType i = 0; i < wordListSize; i++) {
-		SPL::float64 startt = myUtteranceWordsStartTimes[i];
-		auto it = spkIndexMap.find(startt);
-		if (it != spkIndexMap.end()) {
-			rapidjson::SizeType idx = it->second;
-			spkFromNew.push_back(spkFrom[idx]);
-			spkSpkNew.push_back(spkSpk[idx]);
-			spkCfdNew.push_back(spkCfd[idx]);
-			usedSpkIndexes.insert(idx);
-		} else {
-			SPLAPPTRC(L_ERROR, traceIntro << "-->RE40 No speaker label at: " << startt << " insert -1. payload_: " << payload, "ws_receiver");
-			spkFromNew.push_back(startt);
-			spkSpkNew.push_back(-1);
-			spkCfdNew.push_back(-1.0);
-		}
-	}
-	// the skp updates list
-	for (rapidjson::SizeType i = 0; i < spkSize; i++) {
-		std::unordered_set<rapidjson::SizeType>::const_iterator got = usedSpkIndexes.find(i);
-		if (got == usedSpkIndexes.end()) {
-			spkUpdateIndexes.push_back(i);
-		}
-	}
-}
-
-template<typename TUPLE>
-SPL::list<TUPLE> SpeakerProcessor::getUtteranceWordsSpeakerUpdates() const {
-	SPL::list<TUPLE> destination;
-	// spkUpdateIndexes.size() is zero in empty instance, so no invalid references are used
-	for (size_t i = 0; i < spkUpdateIndexes.size(); ++i) {
-		TUPLE theTuple;
-		auto indx = spkUpdateIndexes[i];
-		theTuple.set_startTime(spkFrom[indx]);
-		theTuple.set_speaker(spkSpk[indx]);
-		theTuple.set_confidence(spkCfd[indx]);
-		destination.push_back(theTuple);
-	}
-	return destination;
-}
-
-KeywordProcessor::KeywordProcessor(const DecoderKeywordsResult::ResultMapType & keywordResults_) :
-	isEmpty(false),
-	keywordResults(keywordResults_) {
-}
-
-KeywordProcessor::KeywordProcessor() :
-	// the references to the keywordResults is invalid in this instance
-	// the reference is never used due to isEmpty == true
-	isEmpty(true),
-	keywordResults(DecoderKeywordsResult::ResultMapType()) {
-}
-
-template<typename T>
-void KeywordProcessor::getKeywordsSpottingResults(SPL::map<SPL::rstring, SPL::list<T> > & destination) const {
-	destination.clear();
-	if (not isEmpty) {
-		for (const auto & keyw : keywordResults) {
-			const auto & keyword = keyw.first;
-			SPL::list<T> i;
-			for (const auto & emergence : keyw.second) {
-				T t;
-				t.set_startTime(emergence.start_time);
-				t.set_endTime(emergence.end_time);
-				t.set_confidence(emergence.confidence);
-				i.push_back(t);
-			}
-			destination.insert(typename SPL::map<SPL::rstring, SPL::list<T> >::value_type(keyword, i));
-		}
-	}
-}
-
-template<>
-void KeywordProcessor::getKeywordsSpottingResults<SPL::map<SPL::rstring, SPL::float64> >(SPL::map<SPL::rstring, SPL::list<SPL::map<SPL::rstring, SPL::float64> > > & destination) const {
-	destination.clear();
-	if (not isEmpty) {
-		for (const auto & keyw : keywordResults) {
-			const auto & keyword = keyw.first;
-			SPL::list<SPL::map<SPL::rstring, SPL::float64> > i;
-			for (const auto & emergence : keyw.second) {
-				SPL::map<SPL::rstring, SPL::float64> t;
-				t.insert(SPL::map<SPL::rstring, SPL::float64>::value_type("start_time", emergence.start_time));
-				t.insert(SPL::map<SPL::rstring, SPL::float64>::value_type("set_end_time", emergence.end_time));
-				t.insert(SPL::map<SPL::rstring, SPL::float64>::value_type("confidence", emergence.confidence));
-				i.push_back(t);
-			}
-			destination.insert(SPL::map<SPL::rstring, SPL::list<SPL::map<SPL::rstring, SPL::float64>> >::value_type(keyword, i));
-		}
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::on_session_message(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl, message_ptr msg) {
+	try {
+		on_message(c, s, hdl, msg);
+	} catch (const std::exception & e) {
+		std::stringstream errmess;
+		errmess << traceIntro << "-->RE91m " << typeid(e).name() << " in conversation " << s->conversationId << ": " << e.what();
+		SPLAPPTRC(L_ERROR, errmess.str(), "ws_receiver");
+		abortSessionConnection(c, s, hdl, errmess.str());
+	} catch (const websocketpp::lib::error_code & e) {
+		std::stringstream errmess;
+		errmess << traceIntro << "-->RE92m websocketpp::lib::error_code in conversation " << s->conversationId <<
+				": e=" << e << " message=" << e.message();
+		SPLAPPTRC(L_ERROR, errmess.str(), "ws_receiver");
+		abortSessionConnection(c, s, hdl, errmess.str());
 	}
 }
 
@@ -1046,7 +1672,7 @@ void KeywordProcessor::getKeywordsSpottingResults<SPL::map<SPL::rstring, SPL::fl
 // this callback method will be called from the websocketpp layer.
 // Close will be called exactly once for every connection that open was called for. Close is not called for failed connections.
 template<typename OP, typename OT>
-void WatsonSTTImplReceiver<OP, OT>::on_close(client* c, websocketpp::connection_hdl hdl) {
+void WatsonSTTImplReceiver<OP, OT>::on_close(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl) {
 	// In the lab tests, I noticed that occasionally a Websocket connection can get
 	// closed right after an on_open event without actually receiving the "listening" response
 	// in the on_message event from the Watson STT service. This condition clearly means
@@ -1054,6 +1680,22 @@ void WatsonSTTImplReceiver<OP, OT>::on_close(client* c, websocketpp::connection_
 	// In this case the connection does not reach the state listening and the connection attempt will be repeated in
 	// the connect function of the sender thread
 
+	// ignore the close of a connection which was abandoned after an exception
+	if ( ! isCurrentConnection(*s, hdl)) {
+		SPLAPPTRC(L_INFO, traceIntro << "-->RE87a Ignore close of a previous connection", "ws_receiver");
+		return;
+	}
+	{
+		// a standby session has no conversation: no error tuples are sent
+		SPL::AutoMutex autoMutex(s->mutex);
+		if (s->inStandby.load()) {
+			SPLAPPTRC(L_DEBUG, traceIntro << "-->RE87b Standby connection closed wsState=" <<
+					wsStateToString(s->wsState.load()), "ws_receiver");
+			setWsState(*s, WsState::closed);
+			return;
+		}
+	}
+
 	// get information from ws lib
 	client::connection_ptr con = c->get_con_from_hdl(hdl);
 	int val = con->get_ec().value();
@@ -1061,7 +1703,7 @@ void WatsonSTTImplReceiver<OP, OT>::on_close(client* c, websocketpp::connection_
 	int closecode = con->get_remote_close_code();
 	const std::string & closemess = con->get_remote_close_reason();
 
-	WsState st = wsState.load();
+	WsState st = s->wsState.load();
 	if (st == WsState::closing) {
 		// a connection close was requested
 		SPLAPPTRC(L_INFO, traceIntro <<
@@ -1074,15 +1716,16 @@ void WatsonSTTImplReceiver<OP, OT>::on_close(client* c, websocketpp::connection_
 		std::stringstream errmess;
 		errmess << traceIntro << "-->RE81 Websocket connection closed from listening state ec.value=" << val <<
 				" ec.message=" << mess << " remote_close_code=" << closecode << " remote_close_mesage=" << closemess;
-		sendErrorTuple(errmess.str());
+		sendErrorTuple(*s, errmess.str());
 		SPLAPPTRC(L_ERROR, errmess.str(), "ws_receiver");
 
 		// send a end tuple and window punctuation if a conversation was ongoing
-		OT * myRecentOTuple = recentOTuple.load(); // load atomic
+		OT * myRecentOTuple = loadResultOTuple(*s);
 		if (myRecentOTuple) {
 			if (Config::isTranscriptionCompletedRequested)
 				sendTranscriptionCompletedTuple(myRecentOTuple);
-			splOperator.submit(SPL::Punctuation::WindowMarker, 0);
+			if (not multiplexed)
+				splOperator.submit(SPL::Punctuation::WindowMarker, 0);
 		}
 
 	} else if (st == WsState::error) {
@@ -1095,11 +1738,12 @@ void WatsonSTTImplReceiver<OP, OT>::on_close(client* c, websocketpp::connection_
 				" remote_close_code=" << closecode << " remote_close_mesage=" << closemess, "ws_receiver");
 
 		// send a end tuple and window punctuation if a conversation was ongoing
-		OT * myRecentOTuple = recentOTuple.load(); // load atomic
+		OT * myRecentOTuple = loadResultOTuple(*s);
 		if (myRecentOTuple) {
 			if (Config::isTranscriptionCompletedRequested)
 				sendTranscriptionCompletedTuple(myRecentOTuple);
-			splOperator.submit(SPL::Punctuation::WindowMarker, 0);
+			if (not multiplexed)
+				splOperator.submit(SPL::Punctuation::WindowMarker, 0);
 		}
 
 	} else {
@@ -1110,14 +1754,20 @@ void WatsonSTTImplReceiver<OP, OT>::on_close(client* c, websocketpp::connection_
 				" remote_close_code=" << closecode << " remote_close_mesage=" << closemess, "ws_receiver");
 	}
 
-	recentOTuple.store(nullptr);
-	setWsState(WsState::closed);
+	s->recentOTuple.store(nullptr);
+	setWsState(*s, WsState::closed);
+	if (multiplexed)
+		finishSession(s);
 }
 
 // When a Websocket connection handshake happens with the Watson STT service for enabling
 // TLS security, this callback method will be called from the websocketpp layer.
+// The context is created with the first connection and is re-used for all subsequent connections.
 template<typename OP, typename OT>
 context_ptr WatsonSTTImplReceiver<OP, OT>::on_tls_init(client* c, websocketpp::connection_hdl) {
+	if (sslContext)
+		return sslContext;
+
 	//m_tls_init = std::chrono::high_resolution_clock::now();
 	//context_ptr ctx = websocketpp::lib::make_shared<boost::asio::ssl::context>(boost::asio::ssl::context::tlsv1);
 	context_ptr ctx =
@@ -1128,52 +1778,89 @@ context_ptr WatsonSTTImplReceiver<OP, OT>::on_tls_init(client* c, websocketpp::c
 			boost::asio::ssl::context::no_sslv2 |
 			boost::asio::ssl::context::no_sslv3 |
 			boost::asio::ssl::context::single_dh_use);
+		// enable the client side session cache for the TLS session resumption
+		SSL_CTX_set_session_cache_mode(ctx->native_handle(), SSL_SESS_CACHE_CLIENT);
 	} catch (std::exception& e) {
 		SPLAPPTRC(L_ERROR, traceIntro << "-->" << e.what(), "ws_receiver");
 	}
 
+	sslContext = ctx;
 	return ctx;
 }
 
+// Offer the TLS session of the previous connection to the server. If the server accepts the session,
+// the full handshake is skipped; otherwise a full handshake is made.
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::on_socket_init(websocketpp::connection_hdl,
+		boost::asio::ssl::stream<boost::asio::ip::tcp::socket> & sslStream) {
+	if (sslSession) {
+		if (SSL_set_session(sslStream.native_handle(), sslSession) != 1)
+			SPLAPPTRC(L_WARN, traceIntro << "-->RE8 Can not set TLS session for resumption", "ws_receiver");
+	}
+}
+
 // When a connection attempt to the Watson STT service fails, then this
 // callback method will be called from the websocketpp layer.
 // Either open or fail will be called for each connection. Never both.
 template<typename OP, typename OT>
-void WatsonSTTImplReceiver<OP, OT>::on_fail(client* c, websocketpp::connection_hdl hdl) {
-	recentOTuple.store(nullptr);
-	setWsState(WsState::failed);
+void WatsonSTTImplReceiver<OP, OT>::on_fail(client* c, const SessionPtr & s, websocketpp::connection_hdl hdl) {
+	// ignore the failure of a connection which was abandoned after an exception
+	if ( ! isCurrentConnection(*s, hdl)) {
+		SPLAPPTRC(L_INFO, traceIntro << "-->RE89a Ignore failure of a previous connection", "ws_receiver");
+		return;
+	}
+	{
+		// a standby session has no conversation: no error tuples are sent
+		SPL::AutoMutex autoMutex(s->mutex);
+		if (s->inStandby.load()) {
+			SPLAPPTRC(L_WARN, traceIntro << "-->RE89b Standby connection failed", "ws_receiver");
+			setWsState(*s, WsState::failed);
+			return;
+		}
+	}
 	// c->get_alog().write(websocketpp::log::alevel::app, "Websocket connection to the Watson STT service failed.");
 	client::connection_ptr con = c->get_con_from_hdl(hdl);
 	int val = con->get_ec().value();
 	std::string mess = con->get_ec().message();
 	SPLAPPTRC(L_ERROR, traceIntro << "-->RE89 Websocket connection to the Watson STT service failed. ec.value=" << val <<
 			" ec.message=" << mess, "ws_receiver");
+	// In multiplexed mode there is no connection retry: the conversation fails
+	if (multiplexed) {
+		std::stringstream errmess;
+		errmess << traceIntro << "-->RE89 Websocket connection to the Watson STT service failed for conversation " <<
+				s->conversationId << " ec.value=" << val << " ec.message=" << mess;
+		sendErrorTuple(*s, errmess.str());
+	}
+	s->recentOTuple.store(nullptr);
+	setWsState(*s, WsState::failed);
+	if (multiplexed)
+		finishSession(s);
 }
 
 template<typename OP, typename OT>
-void WatsonSTTImplReceiver<OP, OT>::sendErrorTuple(const std::string & reason) {
+void WatsonSTTImplReceiver<OP, OT>::sendErrorTuple(Session & s, const std::string & reason) {
 	// send out the error with the non finalized output if any
-	if (oTupleUsedForSubmission) {
+	if (s.oTupleUsedForSubmission) {
 		SPLAPPTRC(L_ERROR, traceIntro << "-->RE26 send a non finalized oTupleUsedForSubmission", "ws_receiver");
-		splOperator.appendErrorAttribute(oTupleUsedForSubmission, reason);
-		splOperator.submit(*oTupleUsedForSubmission, 0);
-		splOperator.clearErrorAttribute(oTupleUsedForSubmission);
-		oTupleUsedForSubmission = nullptr;
+		splOperator.appendErrorAttribute(s.oTupleUsedForSubmission, reason);
+		splOperator.submit(*s.oTupleUsedForSubmission, 0);
+		splOperator.clearErrorAttribute(s.oTupleUsedForSubmission);
+		s.oTupleUsedForSubmission = nullptr;
 	} else {
 
 		// send stand alone error tuple if there is a recent otuple
-		OT * myRecentOTuple = recentOTuple.load(); // load atomic
+		OT * myRecentOTuple = loadResultOTuple(s);
 		if (myRecentOTuple) {
 			SPLAPPTRC(L_DEBUG, traceIntro << "-->RE27 append error attribute and send error tuple", "ws_receiver");
 			incrementNFullAudioConversationsFailed();
 			// clean the previous set values in the output tuple
-			splOperator.setResultAttributes(myRecentOTuple, -1, false, -1.0, 0.0, 0.0, "", SPL::list<SPL::rstring>(),
+			splOperator.setResultAttributes(myRecentOTuple, -1, false, -1.0, 0.0, 0.0, -1.0, "", SPL::list<SPL::rstring>(),
 				SPL::list<SPL::rstring>(), SPL::list<SPL::float64>(), SPL::list<SPL::float64>(), SPL::list<SPL::float64>(),
 				SPL::list<SPL::list<SPL::rstring> >(), SPL::list<SPL::list<SPL::float64> >(),
 				SPL::list<SPL::float64>(), SPL::list<SPL::float64>(),
-				emptyKeywordProcessor);
+				emptyKeywordProcessor, emptyPhraseProcessor);
 			if (Config::identifySpeakers)
-				splOperator.setSpeakerResultAttributes(myRecentOTuple, emptySpeakerResults);
+				splOperator.clearSpeakerResultAttributes(myRecentOTuple);
 			// set required output values
 			splOperator.appendErrorAttribute(myRecentOTuple, reason);
 			splOperator.submit(*myRecentOTuple, 0);
@@ -1188,18 +1875,33 @@ template<typename OP, typename OT>
 void WatsonSTTImplReceiver<OP, OT>::sendTranscriptionCompletedTuple(OT * otuple) {
 	SPLAPPTRC(L_DEBUG, traceIntro << "-->RE 30 send transcription completed tuple.", "ws_receiver");
 	// clean the previous set values in the output tuple
-	splOperator.setResultAttributes(otuple, -1, false, -1.0, 0.0, 0.0, "", SPL::list<SPL::rstring>(),
+	splOperator.setResultAttributes(otuple, -1, false, -1.0, 0.0, 0.0, -1.0, "", SPL::list<SPL::rstring>(),
 		SPL::list<SPL::rstring>(), SPL::list<SPL::float64>(), SPL::list<SPL::float64>(), SPL::list<SPL::float64>(),
 		SPL::list<SPL::list<SPL::rstring> >(), SPL::list<SPL::list<SPL::float64> >(),
 		SPL::list<SPL::float64>(), SPL::list<SPL::float64>(),
-		emptyKeywordProcessor);
+		emptyKeywordProcessor, emptyPhraseProcessor);
 	if (Config::identifySpeakers)
-		splOperator.setSpeakerResultAttributes(otuple, emptySpeakerResults);
+		splOperator.clearSpeakerResultAttributes(otuple);
 	// set required output values
 	splOperator.setTranscriptionCompleteAttribute(otuple);
 	splOperator.submit(*otuple, 0);
 }
 
+template<typename OP, typename OT>
+OT * WatsonSTTImplReceiver<OP, OT>::loadResultOTuple(Session & s) {
+	if (s.oTupleUsedForSubmission) {
+		SPLAPPTRC(L_ERROR, traceIntro << "-->RE40 send a non finalized oTupleUsedForSubmission", "ws_receiver");
+		splOperator.submit(*s.oTupleUsedForSubmission, 0);
+		s.oTupleUsedForSubmission = nullptr;
+	}
+	// the sender thread changes the conversation output tuple in place under mutex
+	SPL::AutoMutex autoMutex(s.mutex);
+	if ( ! s.recentOTuple.load())
+		return nullptr;
+	s.resultOTuple = s.conversationOTuple;
+	return &s.resultOTuple;
+}
+
 /*template<typename OP, typename OT>
 bool WatsonSTTImplReceiver<OP, OT>::on_ping(client* c, websocketpp::connection_hdl hdl, std::string mess) {
 	SPLAPPTRC(L_DEBUG, traceIntro << "-->RE99 Websocket ping message=" << mess, "ws_receiver");
@@ -1212,9 +1914,29 @@ void WatsonSTTImplReceiver<OP, OT>::on_pong(client* c, websocketpp::connection_h
 }*/
 
 template<typename OP, typename OT>
-void WatsonSTTImplReceiver<OP, OT>::setWsState(WsState ws) {
-	wsState.store(ws);
-	wsConnectionStateMetric->setValueNoLock(static_cast<SPL::int64>(ws));
+void WatsonSTTImplReceiver<OP, OT>::setWsState(Session & s, WsState ws) {
+	s.wsState.store(ws);
+	// in multiplexed mode the metric wsConnectionState is not meaningful
+	// and standby sessions do not show up in the metric
+	if (not multiplexed && not s.inStandby.load())
+		wsConnectionStateMetric->setValueNoLock(static_cast<SPL::int64>(ws));
+	notifyStateChange();
+}
+
+template<typename OP, typename OT>
+void WatsonSTTImplReceiver<OP, OT>::notifyStateChange() {
+	{
+		// the empty critical section orders the notification after a waiter has checked its condition
+		std::lock_guard<std::mutex> lock(stateChangeMutex);
+	}
+	stateChangeCondition.notify_all();
+}
+
+template<typename OP, typename OT>
+template<typename PRED>
+bool WatsonSTTImplReceiver<OP, OT>::waitForStateChange(SPL::float64 maxWaitTime, PRED pred) {
+	std::unique_lock<std::mutex> lock(stateChangeMutex);
+	return stateChangeCondition.wait_for(lock, std::chrono::duration<SPL::float64>(maxWaitTime), pred);
 }
 
 template<typename OP, typename OT>
@@ -1241,6 +1963,30 @@ void WatsonSTTImplReceiver<OP, OT>::incrementNFullAudioConversationsFailed() {
 	}
 }
 
+template<typename OP, typename OT>
+SPL::float64 WatsonSTTImplReceiver<OP, OT>::measureUtteranceLatency(Session & s, SPL::float64 utteranceEndTime) {
+	const AudioSendTimeline::Clock::time_point now = AudioSendTimeline::Clock::now();
+	// the end offset (exclusive) of the utterance audio; rounded since the result times have a resolution of 10 ms
+	const SPL::float64 endOffset = std::round(utteranceEndTime * audioByteRate);
+	AudioSendTimeline::Clock::time_point sendTime;
+	if ((endOffset < 0.0) || ! s.sendTimeline.getSendTime(static_cast<uint64_t>(endOffset), sendTime)) {
+		SPLAPPTRC(L_DEBUG, traceIntro << "-->RE60 no send time of the audio at utterance end time " << utteranceEndTime, "ws_receiver");
+		return -1.0;
+	}
+	const SPL::int64 latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - sendTime).count();
+	size_t i = 0;
+	while ((i < numUtteranceLatencyBuckets - 1) && (latencyMs > utteranceLatencyBucketBounds[i]))
+		++i;
+	++nUtteranceLatency[i];
+	nUtteranceLatencyTotalMs = nUtteranceLatencyTotalMs + latencyMs;
+	if (latencyMs > utteranceLatencyMaxMs)
+		utteranceLatencyMaxMs = latencyMs;
+	nUtteranceLatencyMetrics[i]->setValueNoLock(nUtteranceLatency[i]);
+	nUtteranceLatencyTotalMsMetric->setValueNoLock(nUtteranceLatencyTotalMs);
+	utteranceLatencyMaxMsMetric->setValueNoLock(utteranceLatencyMaxMs);
+	return std::chrono::duration<SPL::float64>(now - sendTime).count();
+}
+
 const char * wsStateToString(WsState ws) {
 	switch (ws) {
 		case WsState::idle:       return "idle";
@@ -1265,10 +2011,12 @@ bool receiverHasTransientState(WsState ws) {
 }
 
 template<typename OP, typename OT>
-const SpeakerProcessor WatsonSTTImplReceiver<OP, OT>::emptySpeakerResults;
+const KeywordProcessor WatsonSTTImplReceiver<OP, OT>::emptyKeywordProcessor;
+template<typename OP, typename OT>
+const PhraseProcessor WatsonSTTImplReceiver<OP, OT>::emptyPhraseProcessor;
 
 template<typename OP, typename OT>
-const KeywordProcessor WatsonSTTImplReceiver<OP, OT>::emptyKeywordProcessor;
+const SPL::int64 WatsonSTTImplReceiver<OP, OT>::utteranceLatencyBucketBounds[numUtteranceLatencyBuckets - 1] = { 500, 1000, 2000, 4000 };
 
 }}}}
 
@@ -0,0 +1,262 @@
+/*
+ * DecoderBenchmark.cpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Standalone microbenchmark of the hot paths of the WatsonSTT receiver thread:
+ * Decoder::doWork, SpeakerProcessor::run, KeywordProcessor::getKeywordsSpottingResults and PhraseMatcher::match.
+ * The benchmark is compiled with stub SPL types and runs without a Streams installation.
+ *
+ * Usage: DecoderBenchmark [iterations]
+ * Reports messages/s, ns/message and heap allocations/message for each recorded payload.
+ */
+
+#include <SPL/Runtime/Type/SPLType.h>
+#include <SPL/Runtime/Common/RuntimeDebug.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "WatsonSTTConfig.hpp"
+#include "Decoder.hpp"
+#include "SpeakerProcessor.hpp"
+#include "KeywordProcessor.hpp"
+#include "PhraseMatcher.hpp"
+#include "PhraseProcessor.hpp"
+
+// Allocation counter: all heap allocations of the process are counted
+static uint64_t allocations = 0;
+
+void * operator new(size_t size) {
+	++allocations;
+	void * p = std::malloc(size ? size : 1);
+	if ( ! p)
+		throw std::bad_alloc();
+	return p;
+}
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, size_t) noexcept { std::free(p); }
+
+using namespace com::ibm::streams::sttgateway;
+
+namespace {
+
+// Recorded responses of the Watson STT service
+const std::string listening = R"({"state": "listening"})";
+
+const std::string interim = R"({
+   "result_index": 0,
+   "results": [
+      {
+         "final": false,
+         "alternatives": [
+            {
+               "transcript": "thank you for calling customer service how can ",
+               "timestamps": [["thank", 0.12, 0.34], ["you", 0.34, 0.45], ["for", 0.45, 0.58],
+                  ["calling", 0.58, 0.97], ["customer", 0.97, 1.42], ["service", 1.42, 1.88],
+                  ["how", 1.95, 2.1], ["can", 2.1, 2.27]]
+            }
+         ]
+      }
+   ]
+})";
+
+const std::string final = R"({
+   "result_index": 0,
+   "results": [
+      {
+         "final": true,
+         "alternatives": [
+            {
+               "transcript": "thank you for calling customer service how can I help you today ",
+               "confidence": 0.91,
+               "timestamps": [["thank", 0.12, 0.34], ["you", 0.34, 0.45], ["for", 0.45, 0.58],
+                  ["calling", 0.58, 0.97], ["customer", 0.97, 1.42], ["service", 1.42, 1.88],
+                  ["how", 1.95, 2.1], ["can", 2.1, 2.27], ["I", 2.27, 2.33], ["help", 2.33, 2.6],
+                  ["you", 2.6, 2.71], ["today", 2.71, 3.1]],
+               "word_confidence": [["thank", 0.98], ["you", 0.99], ["for", 0.97], ["calling", 0.94],
+                  ["customer", 0.89], ["service", 0.93], ["how", 0.99], ["can", 0.96], ["I", 0.95],
+                  ["help", 0.97], ["you", 0.99], ["today", 0.92]]
+            },
+            { "transcript": "thank you for calling customer services how can I help you today " },
+            { "transcript": "thank you for calling the customer service how can I help you today " }
+         ],
+         "keywords_result": {
+            "customer service": [
+               { "normalized_text": "customer service", "start_time": 0.97, "end_time": 1.88, "confidence": 0.88 }
+            ],
+            "help": [
+               { "normalized_text": "help", "start_time": 2.33, "end_time": 2.6, "confidence": 0.97 }
+            ]
+         },
+         "word_alternatives": [
+            { "start_time": 0.97, "end_time": 1.42, "alternatives": [
+               { "word": "customer", "confidence": 0.89 }, { "word": "costumer", "confidence": 0.08 } ] },
+            { "start_time": 1.42, "end_time": 1.88, "alternatives": [
+               { "word": "service", "confidence": 0.93 }, { "word": "services", "confidence": 0.06 } ] },
+            { "start_time": 2.71, "end_time": 3.1, "alternatives": [
+               { "word": "today", "confidence": 0.92 }, { "word": "to", "confidence": 0.05 } ] }
+         ]
+      }
+   ]
+})";
+
+const std::string speakerLabels = R"({
+   "speaker_labels": [
+      { "from": 0.12, "to": 0.34, "speaker": 0, "confidence": 0.55, "final": false },
+      { "from": 0.34, "to": 0.45, "speaker": 0, "confidence": 0.55, "final": false },
+      { "from": 0.45, "to": 0.58, "speaker": 0, "confidence": 0.55, "final": false },
+      { "from": 0.58, "to": 0.97, "speaker": 0, "confidence": 0.55, "final": false },
+      { "from": 0.97, "to": 1.42, "speaker": 0, "confidence": 0.55, "final": false },
+      { "from": 1.42, "to": 1.88, "speaker": 0, "confidence": 0.55, "final": false },
+      { "from": 1.95, "to": 2.1, "speaker": 1, "confidence": 0.41, "final": false },
+      { "from": 2.1, "to": 2.27, "speaker": 1, "confidence": 0.41, "final": false },
+      { "from": 2.27, "to": 2.33, "speaker": 1, "confidence": 0.41, "final": false },
+      { "from": 2.33, "to": 2.6, "speaker": 1, "confidence": 0.41, "final": false },
+      { "from": 2.6, "to": 2.71, "speaker": 1, "confidence": 0.41, "final": false },
+      { "from": 2.71, "to": 3.1, "speaker": 1, "confidence": 0.41, "final": true },
+      { "from": 0.02, "to": 0.1, "speaker": 0, "confidence": 0.62, "final": true }
+   ]
+})";
+
+// The output tuple types of the speaker updates and the keyword results
+struct SpeakerUpdate {
+	SPL::float64 startTime; SPL::int32 speaker; SPL::float64 confidence;
+	void set_startTime(SPL::float64 v) { startTime = v; }
+	void set_speaker(SPL::int32 v) { speaker = v; }
+	void set_confidence(SPL::float64 v) { confidence = v; }
+};
+struct KeywordEmergence {
+	SPL::float64 startTime; SPL::float64 endTime; SPL::float64 confidence;
+	void set_startTime(SPL::float64 v) { startTime = v; }
+	void set_endTime(SPL::float64 v) { endTime = v; }
+	void set_confidence(SPL::float64 v) { confidence = v; }
+};
+
+// The configuration in the order of the members of WatsonSTTConfig
+// allResults: all output functions are used; otherwise only the utterance text is used
+// moreKeywords: the number of additional keywords which are never spotted
+WatsonSTTConfig makeConfig(bool allResults, size_t moreKeywords = 0) {
+	SPL::list<SPL::rstring> keywords;
+	if (allResults) {
+		keywords = SPL::list<SPL::rstring>{"customer service", "help"};
+		for (size_t i = 0; i < moreKeywords; ++i)
+			keywords.push_back("compliance phrase " + std::to_string(i));
+	}
+	return WatsonSTTConfig{
+		"bench", 0, "bench",
+		false, 0.0, 60.0, false, "wss://localhost", "en-US_NarrowbandModel", "audio/l16;rate=8000",
+		WatsonSTTConfig::partial, true, false, "", "", 9.9, "", false,
+		allResults ? 3 : 1,                      // maxUtteranceAlternatives
+		allResults ? 0.05 : 0.0,                 // wordAlternativesThreshold
+		allResults, allResults, allResults,      // wordConfidenceNeeded, wordTimestampNeeded, identifySpeakers
+		allResults, false, false,                // speakerUpdatesNeeded, smartFormattingNeeded, redactionNeeded
+		allResults ? 0.3 : 0.0,                  // keywordsSpottingThreshold
+		keywords,
+		false, 0.5, 0.0, 0.0,
+		false, 0, 25.0,                          // multiplexed, standbyConnections, standbyRefreshPeriod
+		65536, 0.0, false,                       // audioChunkSize, audioPacingFactor, utteranceLatencyNeeded
+		true, allResults, allResults,            // utteranceTextNeeded, utteranceWordsNeeded, keywordsSpottingResultsNeeded
+		false, "", "", 0.0                       // phraseSpottingResultsNeeded, phraseDictionaryFile, phraseDictionaryAppConfigName, phraseDictionaryReloadPeriod
+	};
+}
+
+// Run fun iterations times and print the result line
+template<typename FUN>
+void measure(const char * name, uint64_t iterations, FUN fun) {
+	// warm up: the decoder buffers reach their working size
+	for (uint64_t i = 0; i < 1000; ++i)
+		fun();
+	const uint64_t allocStart = allocations;
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < iterations; ++i)
+		fun();
+	const auto end = std::chrono::steady_clock::now();
+	const uint64_t allocs = allocations - allocStart;
+	const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	std::printf("%-46s %12.0f msg/s %10.1f ns/msg %8.2f allocs/msg\n",
+			name, iterations / (ns * 1e-9), ns / iterations, static_cast<double>(allocs) / iterations);
+}
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+	const uint64_t iterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000;
+	const WatsonSTTConfig textOnly = makeConfig(false);
+	const WatsonSTTConfig allResults = makeConfig(true);
+	Decoder decText(textOnly);
+	const WatsonSTTConfig manyKeywords = makeConfig(true, 500);
+	Decoder decAll(allResults);
+	Decoder decManyKeywords(manyKeywords);
+
+	std::printf("iterations: %llu\n", static_cast<unsigned long long>(iterations));
+	measure("Decoder listening",                iterations, [&]() { decText.doWork(listening); });
+	measure("Decoder interim (text only)",      iterations, [&]() { decText.doWork(interim); });
+	measure("Decoder final (text only)",        iterations, [&]() { decText.doWork(final); });
+	measure("Decoder interim (all results)",    iterations, [&]() { decAll.doWork(interim); });
+	measure("Decoder final (all results)",      iterations, [&]() { decAll.doWork(final); });
+	measure("Decoder final (502 keywords)",     iterations, [&]() { decManyKeywords.doWork(final); });
+	measure("Decoder speaker_labels",           iterations, [&]() { decAll.doWork(speakerLabels); });
+
+	// the result lists of a final utterance are copied or swapped into the output tuple attributes
+	SPL::list<SPL::rstring> tupleWords;
+	SPL::list<SPL::float64> tupleWordsStartTimes;
+	SPL::list<SPL::list<SPL::rstring> > tupleWordAlternatives;
+	measure("Decoder final + copy into tuple",   iterations, [&]() {
+		decAll.doWork(final);
+		tupleWords = decAll.DecoderAlternatives::getUtteranceWords();
+		tupleWordsStartTimes = decAll.DecoderAlternatives::getUtteranceWordsStartTimes();
+		tupleWordAlternatives = decAll.DecoderWordAlternatives::getWordAlternatives();
+	});
+	measure("Decoder final + swap into tuple",   iterations, [&]() {
+		decAll.doWork(final);
+		SPL::list<SPL::rstring> && words = decAll.DecoderAlternatives::releaseUtteranceWords();
+		tupleWords.swap(words);
+		SPL::list<SPL::float64> && wordsStartTimes = decAll.DecoderAlternatives::releaseUtteranceWordsStartTimes();
+		tupleWordsStartTimes.swap(wordsStartTimes);
+		SPL::list<SPL::list<SPL::rstring> > && wordAlternatives = decAll.DecoderWordAlternatives::releaseWordAlternatives();
+		tupleWordAlternatives.swap(wordAlternatives);
+	});
+
+	// the word start times of the final utterance are the input of the speaker processor
+	decAll.doWork(final);
+	const SPL::list<SPL::float64> wordStartTimes = decAll.DecoderAlternatives::getUtteranceWordsStartTimes();
+	decAll.doWork(speakerLabels);
+	measure("SpeakerProcessor::run",            iterations, [&]() {
+		SpeakerProcessor spkproc(decAll, wordStartTimes, "bench", speakerLabels);
+		spkproc.run();
+		SPL::list<SpeakerUpdate> updates = spkproc.getUtteranceWordsSpeakerUpdates<SpeakerUpdate>();
+	});
+
+	decAll.doWork(final);
+	SPL::map<SPL::rstring, SPL::list<KeywordEmergence> > keywordResults;
+	measure("KeywordProcessor::getKeywordsSpottingResults", iterations, [&]() {
+		const KeywordProcessor keywordProc(decAll);
+		keywordProc.getKeywordsSpottingResults(keywordResults);
+	});
+
+	// a phrase dictionary with 50000 phrases of 1 to 4 words; two phrases are in the final utterance
+	std::vector<std::string> phrases{"customer service", "how can I help you"};
+	for (size_t i = 0; phrases.size() < 50000; ++i)
+		phrases.push_back("product " + std::to_string(i % 5000) + ((i % 3) ? " plan" : "") + ((i % 7) ? "" : " service"));
+	const PhraseMatcher phraseMatcher(phrases);
+	decAll.doWork(final);
+	const SPL::list<SPL::rstring> words = decAll.DecoderAlternatives::getUtteranceWords();
+	const SPL::list<SPL::float64> wordsEndTimes = decAll.DecoderAlternatives::getUtteranceWordsEndTimes();
+	const SPL::list<SPL::float64> wordsConfidences = decAll.DecoderAlternatives::getUtteranceWordsConfidences();
+	std::vector<PhraseHit> phraseHits;
+	std::string wordBuffer;
+	SPL::map<SPL::rstring, SPL::list<KeywordEmergence> > phraseResults;
+	measure("PhraseMatcher::match (50000 phrases)", iterations, [&]() {
+		phraseHits.clear();
+		phraseMatcher.match(words, wordStartTimes, wordsEndTimes, wordsConfidences, 0.9, phraseHits, wordBuffer);
+		const PhraseProcessor phraseProc(&phraseMatcher, phraseHits);
+		phraseProc.getPhraseSpottingResults(phraseResults);
+	});
+	return 0;
+}
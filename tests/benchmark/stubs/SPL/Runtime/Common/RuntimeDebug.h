@@ -0,0 +1,30 @@
+/*
+ * Minimal stand-in for the SPL trace macros. Only for the standalone benchmark and unit tests.
+ * Like in the SPL runtime, the message expression is evaluated only if the level is enabled.
+ * The enabled messages are formatted and discarded; the default level is L_ERROR.
+ */
+#ifndef SPL_RUNTIME_COMMON_RUNTIMEDEBUG_H_STUB
+#define SPL_RUNTIME_COMMON_RUNTIMEDEBUG_H_STUB
+
+#include <sstream>
+
+#define L_ERROR 1
+#define L_WARN  2
+#define L_INFO  3
+#define L_DEBUG 4
+#define L_TRACE 5
+
+namespace SPL { namespace stub {
+inline int & traceLevel() { static int level = L_ERROR; return level; }
+}}
+
+#define SPLAPPTRC(level, msg, aspect) \
+	do { \
+		if ((level) <= SPL::stub::traceLevel()) { \
+			std::ostringstream splStubTrace_; splStubTrace_ << msg; (void) (aspect); \
+		} \
+	} while (0)
+
+#define SPLAPPLOG(level, msg, aspect) SPLAPPTRC(level, msg, aspect)
+
+#endif /* SPL_RUNTIME_COMMON_RUNTIMEDEBUG_H_STUB */
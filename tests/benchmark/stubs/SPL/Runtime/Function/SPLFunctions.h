@@ -0,0 +1,32 @@
+/*
+ * Minimal stand-in for the SPL functions used by the phrase dictionary. Only for the standalone benchmark and
+ * unit tests. The application configurations are set by the test in SPL::stub::applicationConfigurations().
+ */
+#ifndef SPL_RUNTIME_FUNCTION_SPLFUNCTIONS_H_STUB
+#define SPL_RUNTIME_FUNCTION_SPLFUNCTIONS_H_STUB
+
+#include <SPL/Runtime/Type/SPLType.h>
+
+namespace SPL {
+
+namespace stub {
+inline map<rstring, map<rstring, rstring> > & applicationConfigurations() {
+	static map<rstring, map<rstring, rstring> > configurations;
+	return configurations;
+}
+}
+
+namespace Functions { namespace Utility {
+// Returns 0 and the properties if the application configuration exists, otherwise a non zero value
+inline int32 getApplicationConfiguration(map<rstring, rstring> & properties, const rstring & name) {
+	const auto it = stub::applicationConfigurations().find(name);
+	if (it == stub::applicationConfigurations().end())
+		return 1;
+	properties = it->second;
+	return 0;
+}
+}}
+
+} // namespace SPL
+
+#endif /* SPL_RUNTIME_FUNCTION_SPLFUNCTIONS_H_STUB */
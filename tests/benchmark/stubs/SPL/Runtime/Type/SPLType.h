@@ -0,0 +1,68 @@
+/*
+ * Minimal stand-in for the SPL runtime types used by the decoder, the speaker processor
+ * and the keyword processor. Only for the standalone benchmark and unit tests; the operator is always
+ * compiled against the SPL runtime of the Streams installation.
+ */
+#ifndef SPL_RUNTIME_TYPE_SPLTYPE_H_STUB
+#define SPL_RUNTIME_TYPE_SPLTYPE_H_STUB
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <ostream>
+#include <initializer_list>
+#include <utility>
+
+namespace SPL {
+
+typedef bool boolean;
+typedef int32_t int32;
+typedef int64_t int64;
+typedef double float64;
+
+class rstring : public std::string {
+public:
+	rstring() : std::string() {}
+	rstring(const char * s) : std::string(s) {}
+	rstring(const char * s, size_t n) : std::string(s, n) {}
+	rstring(const std::string & s) : std::string(s) {}
+	rstring(std::string && s) : std::string(std::move(s)) {}
+	const std::string & string() const { return *this; }
+};
+
+template<typename T>
+class list : public std::vector<T> {
+public:
+	list() : std::vector<T>() {}
+	list(std::initializer_list<T> il) : std::vector<T>(il) {}
+	void pushBack(const T & t) { this->push_back(t); }
+};
+
+template<typename K, typename V>
+class map : public std::unordered_map<K, V> {
+public:
+	map() : std::unordered_map<K, V>() {}
+};
+
+template<typename T>
+std::ostream & operator<<(std::ostream & os, const list<T> & l) {
+	os << "[";
+	for (size_t i = 0; i < l.size(); ++i) {
+		if (i > 0)
+			os << ",";
+		os << l[i];
+	}
+	return os << "]";
+}
+
+} // namespace SPL
+
+namespace std {
+template<>
+struct hash<SPL::rstring> {
+	size_t operator()(const SPL::rstring & s) const { return hash<std::string>()(s); }
+};
+}
+
+#endif /* SPL_RUNTIME_TYPE_SPLTYPE_H_STUB */
@@ -0,0 +1,55 @@
+#--variantList='modePartial modeComplete'
+#--timeout=1200
+
+TT_mainComposite='WatsonSTTMultiplexed'
+TT_sabFile="output/WatsonSTTMultiplexed.sab"
+
+declare -A description=(
+	[modePartial]='######################## Multiplexed mode; interleaved conversations; sttResultMode partial; Expect success ###'
+	[modeComplete]='######################## Multiplexed mode; interleaved conversations; sttResultMode complete; Expect success ###'
+)
+
+PREPS=(
+	'echo "${description[$TTRO_variantCase]}"'
+	'copyAndMorphSpl'
+	'splCompile --c++std=c++11'
+	'TT_traceLevel="info"'
+)
+
+STEPS=(
+	'submitJob -P "audioDir=$TTPR_SreamsxSttgatewaySamplesPath/audio-files" -P "apiKey=$TTPR_SpeechToTextApikey" -P "uri=$TTPR_SpeechToTextUrl/v1/recognize"'
+	'checkJobNo'
+	'waitForJobHealth'
+	'waitForFinAndCheckHealth'
+	'cancelJobAndLog'
+	'myEvaluate'
+)
+
+FINS=(
+	'cancelJobAndLog'
+)
+
+# Every conversation gets its own final utterances and its own transcription completed tuple.
+# The failed conversation does not stop the others. The final marker is forwarded after all
+# conversations have ended.
+myEvaluate() {
+	if ! linewisePatternMatchArray "$TTRO_workDirCase/data/Tuples" 'true'; then
+		setFailure "Not enough pattern matches found"
+	fi
+	local conv
+	for conv in 01-call-center-10sec.wav 10-invalid-audio.wav 12-jfk-speech-12sec.wav; do
+		local linecount=$(grep "conversationId=\"$conv\".*transcriptionCompleted=true" "$TTRO_workDirCase/data/Tuples" | wc -l)
+		if [[ $linecount -ne 1 ]]; then
+			setFailure "Conversation $conv has $linecount transcription completed tuples; expected 1"
+		fi
+	done
+	if [[ ! -e "$TT_dataDir/FinalMarker" ]]; then
+		setFailure "No final marker received"
+	fi
+}
+
+TTTT_patternList=(
+	'*conversationId="01-call-center-10sec.wav"*utteranceText="hi I am John Smith *'
+	'*conversationId="12-jfk-speech-12sec.wav"*utteranceText="and so my fellow Americans*'
+	'*conversationId="10-invalid-audio.wav"*sttErrorMessage="unable to transcode*'
+)
@@ -1,4 +1,4 @@
-#--variantCount=3
+#--variantCount=7
 
 setCategory 'quick'
 
@@ -9,6 +9,10 @@ declare -a description=(
 	'#### variant 0 - good case ####################################'
 	'#### variant 1 - missing input attribute ####################################'
 	'#### variant 2 - input attribute wrong type ####################################'
+	'#### variant 3 - good case phrase dictionary file ####################################'
+	'#### variant 4 - good case phrase dictionary application configuration ####################################'
+	'#### variant 5 - getPhraseSpottingResults without phrase dictionary ####################################'
+	'#### variant 6 - getPhraseSpottingResults wrong type ####################################'
 )
 
 PREPS=(
@@ -22,17 +26,23 @@ STEPS=(
 )
 
 myCompile() {
-	if [[ $TTRO_variantCase -eq 0 ]]; then
-		splCompileInterceptAndSuccess '--c++std=c++11'
-	else
-		splCompileInterceptAndError	'--c++std=c++11'
-	fi
+	case "$TTRO_variantCase" in
+	0|3|4)
+		splCompileInterceptAndSuccess '--c++std=c++11';;
+	*)
+		splCompileInterceptAndError	'--c++std=c++11';;
+	esac
 }
 
 myEval() {
-	if [[ $TTRO_variantCase -eq 0 ]]; then
-		return 0
-	fi
+	case "$TTRO_variantCase" in
+	0|3|4)
+		return 0;;
+	5|6)
+		# the messages of the phrase spotting are not translated
+		linewisePatternMatchInterceptAndSuccess "$TT_evaluationFile" "" "${phraseErrorCodes[$((TTRO_variantCase - 5))]}"
+		return 0;;
+	esac
 	local variantCase=$((TTRO_variantCase - 1 ))
 	case "$TTRO_variantSuite" in
 	de_DE)
@@ -56,6 +66,11 @@ myEval() {
 	esac;
 }
 
+phraseErrorCodes=(
+	"*Output function getPhraseSpottingResults requires parameter phraseDictionaryFile or phraseDictionaryAppConfigName*"
+	"*Attribute phrases has wrong type! It must be of type map<rstring,list<tuple<float64 startTime,float64 endTime,float64 confidence>>> or map<rstring,list<map<rstring,float64>>>*"
+)
+
 errorCodes=(
 	"*CDIST3801E: Operator WatsonSTT: The required input tuple attribute 'speech' is missing in*"
 	"*CDIST3802E: Operator WatsonSTT: The required input tuple attribute 'speech' is not of type*"
@@ -0,0 +1,106 @@
+/*
+ * AudioPacerTest.cpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Unit test of getAudioByteRate and AudioPacer
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "AudioPacer.hpp"
+#include "UnitTest.hpp"
+
+using namespace com::ibm::streams::sttgateway;
+
+namespace {
+
+double seconds(AudioPacer::Clock::duration d) {
+	return std::chrono::duration<double>(d).count();
+}
+
+void testByteRate() {
+	// l16 has 2 bytes per sample
+	CHECK_NEAR(getAudioByteRate("audio/l16;rate=16000"), 32000.0, 1e-9);
+	CHECK_NEAR(getAudioByteRate("audio/l16;rate=8000"), 16000.0, 1e-9);
+	CHECK_NEAR(getAudioByteRate("audio/l16;rate=16000;channels=2"), 64000.0, 1e-9);
+	CHECK_NEAR(getAudioByteRate("audio/l16; rate=22050; endianness=little-endian"), 44100.0, 1e-9);
+	CHECK_NEAR(getAudioByteRate("Audio/L16;Rate=16000"), 32000.0, 1e-9);
+	// mulaw and alaw have 1 byte per sample
+	CHECK_NEAR(getAudioByteRate("audio/mulaw;rate=8000"), 8000.0, 1e-9);
+	CHECK_NEAR(getAudioByteRate("audio/mulaw;rate=16000"), 16000.0, 1e-9);
+	CHECK_NEAR(getAudioByteRate("audio/mulaw;rate=8000;channels=2"), 16000.0, 1e-9);
+	CHECK_NEAR(getAudioByteRate("audio/alaw;rate=8000"), 8000.0, 1e-9);
+	// basic is single channel mulaw with 8000 samples per second
+	CHECK_NEAR(getAudioByteRate("audio/basic"), 8000.0, 1e-9);
+	// the rate is required for l16, mulaw and alaw
+	CHECK(getAudioByteRate("audio/l16") == 0.0);
+	CHECK(getAudioByteRate("audio/mulaw") == 0.0);
+	CHECK(getAudioByteRate("audio/l16;rate=0") == 0.0);
+	CHECK(getAudioByteRate("audio/l16;rate=-8000") == 0.0);
+	CHECK(getAudioByteRate("audio/l16;rate=abc") == 0.0);
+	CHECK(getAudioByteRate("audio/l16;rate=16000;channels=0") == 0.0);
+	// compressed formats and formats with a header have no byte rate
+	CHECK(getAudioByteRate("audio/wav") == 0.0);
+	CHECK(getAudioByteRate("audio/flac") == 0.0);
+	CHECK(getAudioByteRate("audio/ogg;codecs=opus") == 0.0);
+	CHECK(getAudioByteRate("application/octet-stream") == 0.0);
+	CHECK(getAudioByteRate("") == 0.0);
+	CHECK(getAudioByteRate(";rate=16000") == 0.0);
+	CHECK(getAudioByteRate("audio/l16x;rate=16000") == 0.0);
+}
+
+void testSchedule() {
+	AudioPacer pacer;
+	// 1000 bytes per second: each chunk of 100 bytes is due 0.1 seconds after the previous chunk
+	const AudioPacer::Clock::time_point first = pacer.schedule(100, 1000.0, 10.0);
+	const AudioPacer::Clock::time_point second = pacer.schedule(100, 1000.0, 10.0);
+	const AudioPacer::Clock::time_point third = pacer.schedule(50, 1000.0, 10.0);
+	const AudioPacer::Clock::time_point fourth = pacer.schedule(100, 1000.0, 10.0);
+	CHECK(first <= AudioPacer::Clock::now());
+	CHECK_NEAR(seconds(second - first), 0.1, 1e-6);
+	CHECK_NEAR(seconds(third - first), 0.2, 1e-6);
+	CHECK_NEAR(seconds(fourth - first), 0.25, 1e-6);
+
+	// a new conversation starts a new schedule
+	pacer.reset();
+	const AudioPacer::Clock::time_point before = AudioPacer::Clock::now();
+	const AudioPacer::Clock::time_point restart = pacer.schedule(100, 1000.0, 10.0);
+	CHECK(restart >= before);
+	CHECK(restart <= AudioPacer::Clock::now());
+}
+
+void testLagCatchUp() {
+	AudioPacer pacer;
+	// 1000000 bytes per second: the second chunk is due 1 ms after the first chunk
+	const AudioPacer::Clock::time_point first = pacer.schedule(1000, 1000000.0, 0.02);
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	// the audio is 99 ms late, more than the maximum lag of 20 ms: the schedule is moved forward
+	// and the late chunk is due now instead of in the past
+	const AudioPacer::Clock::time_point before = AudioPacer::Clock::now();
+	const AudioPacer::Clock::time_point second = pacer.schedule(1000, 1000000.0, 0.02);
+	CHECK(second >= before);
+	CHECK(seconds(second - first) >= 0.1);
+	// the following chunks are scheduled from the new start and are not sent in a burst
+	const AudioPacer::Clock::time_point third = pacer.schedule(1000, 1000000.0, 0.02);
+	CHECK_NEAR(seconds(third - second), 0.001, 1e-6);
+
+	// audio which is late less than the maximum lag keeps the schedule: the backlog is sent without wait
+	AudioPacer tolerant;
+	const AudioPacer::Clock::time_point start = tolerant.schedule(1000, 1000000.0, 10.0);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	const AudioPacer::Clock::time_point late = tolerant.schedule(1000, 1000000.0, 10.0);
+	CHECK_NEAR(seconds(late - start), 0.001, 1e-6);
+	CHECK(late < AudioPacer::Clock::now());
+}
+
+} // namespace
+
+int main() {
+	testByteRate();
+	testSchedule();
+	testLagCatchUp();
+	return unittest::result("AudioPacerTest");
+}
@@ -0,0 +1,88 @@
+/*
+ * AudioSendTimelineTest.cpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Unit test of AudioSendTimeline
+ */
+
+#include <chrono>
+
+#include "AudioSendTimeline.hpp"
+#include "UnitTest.hpp"
+
+using namespace com::ibm::streams::sttgateway;
+
+namespace {
+
+typedef AudioSendTimeline::Clock Clock;
+
+// send time of the chunk number i
+Clock::time_point at(const Clock::time_point & t0, int i) {
+	return t0 + std::chrono::milliseconds(i);
+}
+
+void testLookup() {
+	const Clock::time_point t0 = Clock::now();
+	AudioSendTimeline timeline;
+	Clock::time_point sendTime;
+	// nothing was sent
+	CHECK( ! timeline.getSendTime(100, sendTime));
+
+	// three chunks with the offsets [0,100) [100,250) [250,300)
+	timeline.record(100, at(t0, 1));
+	timeline.record(0, at(t0, 9));
+	timeline.record(150, at(t0, 2));
+	timeline.record(50, at(t0, 3));
+
+	// the last byte before offset 100 is in the first chunk
+	CHECK(timeline.getSendTime(100, sendTime));
+	CHECK(sendTime == at(t0, 1));
+	// the same offset can be requested again
+	CHECK(timeline.getSendTime(100, sendTime));
+	CHECK(sendTime == at(t0, 1));
+	// the last byte before offset 101 is in the second chunk
+	CHECK(timeline.getSendTime(101, sendTime));
+	CHECK(sendTime == at(t0, 2));
+	CHECK(timeline.getSendTime(250, sendTime));
+	CHECK(sendTime == at(t0, 2));
+	// the results arrive in the order of the audio: the first chunk was discarded
+	CHECK( ! timeline.getSendTime(100, sendTime));
+	CHECK(timeline.getSendTime(300, sendTime));
+	CHECK(sendTime == at(t0, 3));
+	// this audio was not yet sent
+	CHECK( ! timeline.getSendTime(301, sendTime));
+
+	// a new conversation starts at offset 0
+	timeline.reset();
+	CHECK( ! timeline.getSendTime(10, sendTime));
+	timeline.record(10, at(t0, 4));
+	CHECK(timeline.getSendTime(10, sendTime));
+	CHECK(sendTime == at(t0, 4));
+}
+
+void testBound() {
+	const Clock::time_point t0 = Clock::now();
+	AudioSendTimeline timeline;
+	Clock::time_point sendTime;
+	// no result arrives: the oldest chunks are discarded
+	const int n = static_cast<int>(AudioSendTimeline::maxChunks) + 10;
+	for (int i = 0; i < n; ++i)
+		timeline.record(10, at(t0, i));
+	CHECK( ! timeline.getSendTime(10, sendTime));
+	CHECK( ! timeline.getSendTime(100, sendTime));
+	// the oldest kept chunk is number 10 with the offsets [100,110)
+	CHECK(timeline.getSendTime(101, sendTime));
+	CHECK(sendTime == at(t0, 10));
+	CHECK(timeline.getSendTime(10 * n, sendTime));
+	CHECK(sendTime == at(t0, n - 1));
+}
+
+} // namespace
+
+int main() {
+	testLookup();
+	testBound();
+	return unittest::result("AudioSendTimelineTest");
+}
@@ -0,0 +1,158 @@
+/*
+ * KeywordProcessorTest.cpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Unit test of the keyword results of the decoder with the hash index of keywordsToBeSpotted and of KeywordProcessor
+ */
+
+#include <SPL/Runtime/Type/SPLType.h>
+#include <SPL/Runtime/Common/RuntimeDebug.h>
+
+#include <string>
+
+#include "Decoder.hpp"
+#include "KeywordProcessor.hpp"
+#include "TestConfig.hpp"
+#include "UnitTest.hpp"
+
+using namespace com::ibm::streams::sttgateway;
+
+namespace {
+
+struct KeywordEmergence {
+	SPL::float64 startTime; SPL::float64 endTime; SPL::float64 confidence;
+	void set_startTime(SPL::float64 v) { startTime = v; }
+	void set_endTime(SPL::float64 v) { endTime = v; }
+	void set_confidence(SPL::float64 v) { confidence = v; }
+};
+
+// A final result with the keywords_result; the keyword "other" is not in keywordsToBeSpotted
+const std::string final1 = R"({
+   "result_index": 0,
+   "results": [
+      {
+         "final": true,
+         "alternatives": [
+            {
+               "transcript": "I need help with my customer service help ",
+               "confidence": 0.91,
+               "timestamps": [["I", 0.1, 0.2], ["need", 0.2, 0.4], ["help", 0.4, 0.7], ["with", 0.7, 0.8],
+                  ["my", 0.8, 0.9], ["customer", 0.9, 1.3], ["service", 1.3, 1.8], ["help", 1.8, 2.1]],
+               "word_confidence": [["I", 0.9], ["need", 0.9], ["help", 0.9], ["with", 0.9],
+                  ["my", 0.9], ["customer", 0.9], ["service", 0.9], ["help", 0.9]]
+            }
+         ],
+         "keywords_result": {
+            "help": [
+               { "normalized_text": "help", "start_time": 0.4, "end_time": 0.7, "confidence": 0.97 },
+               { "normalized_text": "help", "start_time": 1.8, "end_time": 2.1, "confidence": 0.95 }
+            ],
+            "other": [
+               { "normalized_text": "other", "start_time": 0.8, "end_time": 0.9, "confidence": 0.5 }
+            ],
+            "customer service": [
+               { "normalized_text": "customer service", "start_time": 0.9, "end_time": 1.8, "confidence": 0.88 }
+            ]
+         }
+      }
+   ]
+})";
+
+const std::string final2 = R"({
+   "result_index": 1,
+   "results": [
+      {
+         "final": true,
+         "alternatives": [
+            {
+               "transcript": "refund ",
+               "confidence": 0.8,
+               "timestamps": [["refund", 2.5, 3.0]],
+               "word_confidence": [["refund", 0.8]]
+            }
+         ],
+         "keywords_result": {
+            "refund": [
+               { "normalized_text": "refund", "start_time": 2.5, "end_time": 3.0, "confidence": 0.8 }
+            ]
+         }
+      }
+   ]
+})";
+
+void testIndex(Decoder & dec) {
+	size_t idx = 99;
+	CHECK(dec.DecoderKeywordsResult::findKeyword("help", idx));
+	CHECK(idx == 1);
+	// a duplicate keyword is mapped to the first entry
+	CHECK(dec.DecoderKeywordsResult::findKeyword("customer service", idx));
+	CHECK(idx == 0);
+	CHECK(dec.DecoderKeywordsResult::findKeyword("refund", idx));
+	CHECK(idx == 2);
+	// the lookup is case sensitive like the keywords_result of the STT service
+	CHECK( ! dec.DecoderKeywordsResult::findKeyword("Help", idx));
+	CHECK( ! dec.DecoderKeywordsResult::findKeyword("other", idx));
+	CHECK( ! dec.DecoderKeywordsResult::findKeyword("", idx));
+}
+
+void testResults(Decoder & dec) {
+	dec.doWork(final1);
+	CHECK(dec.DecoderKeywordsResult::hasResult());
+	// the hits are in the order of the keywords_result; the unknown keyword is skipped
+	CHECK((dec.DecoderKeywordsResult::getKeywordHits() == std::vector<size_t>{1, 0}));
+	CHECK(dec.DecoderKeywordsResult::getKeywordEmergences(1).size() == 2);
+	CHECK(dec.DecoderKeywordsResult::getKeywordEmergences(2).empty());
+
+	SPL::map<SPL::rstring, SPL::list<KeywordEmergence> > results;
+	// the entries of a previous result without emergences are erased
+	results["refund"].resize(1);
+	results["stale"].resize(1);
+	KeywordProcessor(dec).getKeywordsSpottingResults(results);
+	CHECK(results.size() == 2);
+	CHECK(results["help"].size() == 2);
+	CHECK(results["customer service"].size() == 1);
+	if (results["help"].size() == 2) {
+		CHECK(results["help"][1].startTime == 1.8);
+		CHECK(results["help"][1].endTime == 2.1);
+		CHECK(results["help"][1].confidence == 0.95);
+	}
+
+	// the next result resets the emergences of the last result
+	dec.doWork(final2);
+	CHECK((dec.DecoderKeywordsResult::getKeywordHits() == std::vector<size_t>{2}));
+	CHECK(dec.DecoderKeywordsResult::getKeywordEmergences(1).empty());
+	KeywordProcessor(dec).getKeywordsSpottingResults(results);
+	CHECK(results.size() == 1);
+	CHECK(results["refund"].size() == 1);
+
+	// no keyword result clears the results
+	dec.doWork(R"({"state": "listening"})");
+	CHECK( ! dec.DecoderKeywordsResult::hasResult());
+	KeywordProcessor(dec).getKeywordsSpottingResults(results);
+	CHECK(results.empty());
+	results["help"].resize(1);
+	KeywordProcessor().getKeywordsSpottingResults(results);
+	CHECK(results.empty());
+}
+
+void testNoKeywords() {
+	// without keywordsToBeSpotted every keyword of the keywords_result is skipped
+	const WatsonSTTConfig config = unittest::makeConfig(SPL::list<SPL::rstring>());
+	Decoder dec(config);
+	dec.doWork(final1);
+	CHECK( ! dec.DecoderKeywordsResult::hasResult());
+}
+
+} // namespace
+
+int main() {
+	const WatsonSTTConfig config = unittest::makeConfig(
+			SPL::list<SPL::rstring>{"customer service", "help", "refund", "customer service"});
+	Decoder dec(config);
+	testIndex(dec);
+	testResults(dec);
+	testNoKeywords();
+	return unittest::result("KeywordProcessorTest");
+}
@@ -0,0 +1,79 @@
+/*
+ * LatencyHistogramTest.cpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Unit test of LatencyHistogram
+ */
+
+#include <sstream>
+#include <string>
+
+#include "LatencyHistogram.hpp"
+#include "UnitTest.hpp"
+
+using namespace com::ibm::streams::sttgateway;
+
+namespace {
+
+bool contains(const std::string & text, const std::string & line) {
+	return text.find(line + "\n") != std::string::npos;
+}
+
+void testBuckets() {
+	LatencyHistogram h;
+	h.record(0);
+	h.record(1);
+	h.record(2);
+	h.record(3);
+	h.record(1024);
+	h.record(1025);
+	// larger than the last bound 2^24
+	h.record(uint64_t(1) << 30);
+
+	LatencyHistogram::Snapshot snapshot;
+	snapshot.add(h);
+	snapshot.add(h);
+	CHECK(snapshot.buckets[0] == 4);
+	CHECK(snapshot.buckets[1] == 2);
+	CHECK(snapshot.buckets[2] == 2);
+	CHECK(snapshot.buckets[10] == 2);
+	CHECK(snapshot.buckets[11] == 2);
+	CHECK(snapshot.buckets[LatencyHistogram::numBuckets - 1] == 2);
+	CHECK(snapshot.count == 14);
+
+	std::ostringstream os;
+	snapshot.write(os, "t", "test");
+	const std::string text = os.str();
+	CHECK(contains(text, "# TYPE t histogram"));
+	CHECK(contains(text, "t_bucket{le=\"1\"} 4"));
+	CHECK(contains(text, "t_bucket{le=\"2\"} 6"));
+	CHECK(contains(text, "t_bucket{le=\"1024\"} 10"));
+	CHECK(contains(text, "t_bucket{le=\"16777216\"} 12"));
+	CHECK(contains(text, "t_bucket{le=\"+Inf\"} 14"));
+	CHECK(contains(text, "t_count 14"));
+}
+
+void testConsistentCount() {
+	// a record may be read between the update of its bucket and the update of the count
+	LatencyHistogram::Snapshot snapshot;
+	snapshot.buckets[3] = 5;
+	snapshot.buckets[LatencyHistogram::numBuckets - 1] = 2;
+	snapshot.count = 6;
+	std::ostringstream os;
+	snapshot.write(os, "t", "test");
+	const std::string text = os.str();
+	// the +Inf bucket and the count are the sum of the buckets
+	CHECK(contains(text, "t_bucket{le=\"16777216\"} 5"));
+	CHECK(contains(text, "t_bucket{le=\"+Inf\"} 7"));
+	CHECK(contains(text, "t_count 7"));
+}
+
+} // namespace
+
+int main() {
+	testBuckets();
+	testConsistentCount();
+	return unittest::result("LatencyHistogramTest");
+}
@@ -0,0 +1,144 @@
+/*
+ * PhraseDictionaryTest.cpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Unit test of PhraseDictionary with a temporary file and the application configurations of the SPL stub
+ */
+
+#include <SPL/Runtime/Type/SPLType.h>
+#include <SPL/Runtime/Function/SPLFunctions.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+#include "PhraseDictionary.hpp"
+#include "UnitTest.hpp"
+
+using namespace com::ibm::streams::sttgateway;
+
+namespace {
+
+void writeFile(const std::string & name, const std::string & content) {
+	std::ofstream file(name, std::ios::trunc);
+	file << content;
+}
+
+bool hasPhrase(const PhraseMatcher & matcher, const std::string & phrase) {
+	for (uint32_t i = 0; i < matcher.size(); ++i)
+		if (matcher.getPhrase(i) == phrase)
+			return true;
+	return false;
+}
+
+bool throws(PhraseDictionary & dictionary) {
+	try {
+		dictionary.loadIfChanged();
+	} catch (const std::runtime_error &) {
+		return true;
+	}
+	return false;
+}
+
+void testFile(const std::string & fileName) {
+	// one phrase per line; the empty lines and the comments are ignored and the phrases are trimmed
+	writeFile(fileName, "# the dictionary\ncustomer service\n\n  \t\n  how can I help you \r\n   # indented comment\nrefund\n");
+	PhraseDictionary dictionary(fileName, "");
+	PhraseDictionary::MatcherPtr matcher = dictionary.loadIfChanged();
+	CHECK(matcher);
+	if (matcher) {
+		CHECK(matcher->size() == 3);
+		CHECK(hasPhrase(*matcher, "customer service"));
+		CHECK(hasPhrase(*matcher, "how can I help you"));
+		CHECK(hasPhrase(*matcher, "refund"));
+	}
+	// the file has not changed
+	CHECK( ! dictionary.loadIfChanged());
+
+	// the file has changed
+	writeFile(fileName, "customer service\nrefund\ncancel my contract\n");
+	matcher = dictionary.loadIfChanged();
+	CHECK(matcher);
+	if (matcher) {
+		CHECK(matcher->size() == 3);
+		CHECK(hasPhrase(*matcher, "cancel my contract"));
+		CHECK( ! hasPhrase(*matcher, "how can I help you"));
+	}
+
+	// a missing file is an error; the last state is kept
+	std::remove(fileName.c_str());
+	CHECK(throws(dictionary));
+	writeFile(fileName, "customer service\nrefund\n");
+	matcher = dictionary.loadIfChanged();
+	CHECK(matcher);
+	if (matcher)
+		CHECK(matcher->size() == 2);
+
+	// an empty dictionary
+	writeFile(fileName, "# no phrases\n\n");
+	matcher = dictionary.loadIfChanged();
+	CHECK(matcher);
+	if (matcher)
+		CHECK(matcher->size() == 0);
+
+	PhraseDictionary missing(fileName + ".missing", "");
+	CHECK(throws(missing));
+	std::remove(fileName.c_str());
+}
+
+void testAppConfig(const std::string & fileName) {
+	SPL::map<SPL::rstring, SPL::rstring> & properties = SPL::stub::applicationConfigurations()["phrases"];
+	properties["p1"] = "customer service";
+	properties["p2"] = "refund";
+	writeFile(fileName, "cancel my contract\n");
+
+	// the phrases of the file and of the application configuration are merged
+	PhraseDictionary dictionary(fileName, "phrases");
+	PhraseDictionary::MatcherPtr matcher = dictionary.loadIfChanged();
+	CHECK(matcher);
+	if (matcher) {
+		CHECK(matcher->size() == 3);
+		CHECK(hasPhrase(*matcher, "cancel my contract"));
+		CHECK(hasPhrase(*matcher, "customer service"));
+		CHECK(hasPhrase(*matcher, "refund"));
+	}
+	CHECK( ! dictionary.loadIfChanged());
+
+	// a changed property value
+	properties["p2"] = "chargeback";
+	matcher = dictionary.loadIfChanged();
+	CHECK(matcher);
+	if (matcher) {
+		CHECK(hasPhrase(*matcher, "chargeback"));
+		CHECK( ! hasPhrase(*matcher, "refund"));
+	}
+	CHECK( ! dictionary.loadIfChanged());
+
+	// a missing application configuration is an error
+	SPL::stub::applicationConfigurations().erase("phrases");
+	CHECK(throws(dictionary));
+	// an empty application configuration is an empty dictionary
+	SPL::stub::applicationConfigurations()["empty"];
+	PhraseDictionary empty("", "empty");
+	matcher = empty.loadIfChanged();
+	CHECK(matcher);
+	if (matcher)
+		CHECK(matcher->size() == 0);
+	CHECK( ! empty.loadIfChanged());
+	std::remove(fileName.c_str());
+}
+
+} // namespace
+
+int main() {
+	const char * tmp = std::getenv("TMPDIR");
+	const std::string fileName = std::string(tmp ? tmp : "/tmp") + "/PhraseDictionaryTest." + std::to_string(getpid());
+	testFile(fileName);
+	testAppConfig(fileName);
+	return unittest::result("PhraseDictionaryTest");
+}
@@ -0,0 +1,207 @@
+/*
+ * PhraseMatcherTest.cpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Unit test of PhraseMatcher and PhraseProcessor
+ */
+
+#include <SPL/Runtime/Type/SPLType.h>
+
+#include <string>
+#include <vector>
+
+#include "PhraseMatcher.hpp"
+#include "PhraseProcessor.hpp"
+#include "UnitTest.hpp"
+
+using namespace com::ibm::streams::sttgateway;
+
+namespace {
+
+struct PhraseEmergence {
+	SPL::float64 startTime; SPL::float64 endTime; SPL::float64 confidence;
+	void set_startTime(SPL::float64 v) { startTime = v; }
+	void set_endTime(SPL::float64 v) { endTime = v; }
+	void set_confidence(SPL::float64 v) { confidence = v; }
+};
+
+// An utterance with the word i from i to i + 1 seconds and the confidence 0.9 - i / 100
+struct Utterance {
+	SPL::list<SPL::rstring> words;
+	SPL::list<SPL::float64> startTimes;
+	SPL::list<SPL::float64> endTimes;
+	SPL::list<SPL::float64> confidences;
+
+	explicit Utterance(const std::vector<std::string> & words_) {
+		for (size_t i = 0; i < words_.size(); ++i) {
+			words.push_back(words_[i]);
+			startTimes.push_back(static_cast<SPL::float64>(i));
+			endTimes.push_back(static_cast<SPL::float64>(i + 1));
+			confidences.push_back(0.9 - static_cast<SPL::float64>(i) / 100.0);
+		}
+	}
+};
+
+std::vector<PhraseHit> match(const PhraseMatcher & matcher, const Utterance & u) {
+	std::vector<PhraseHit> hits;
+	std::string wordBuffer;
+	matcher.match(u.words, u.startTimes, u.endTimes, u.confidences, 0.5, hits, wordBuffer);
+	return hits;
+}
+
+// The phrase text, the index of the first and of the last word of a hit
+bool isHit(const PhraseMatcher & matcher, const PhraseHit & hit, const std::string & phrase, int first, int last) {
+	return (matcher.getPhrase(hit.phrase) == phrase) && (hit.startTime == first) && (hit.endTime == last + 1);
+}
+
+void testMatch() {
+	const PhraseMatcher matcher(std::vector<std::string>{"customer service", "help", "how can I help you"});
+	CHECK(matcher.size() == 3);
+	const Utterance u(std::vector<std::string>{"thank", "you", "for", "calling", "customer", "service",
+		"how", "can", "I", "help", "you", "today"});
+	const std::vector<PhraseHit> hits = match(matcher, u);
+	// the hits are in the order of their last word
+	CHECK(hits.size() == 3);
+	if (hits.size() == 3) {
+		CHECK(isHit(matcher, hits[0], "customer service", 4, 5));
+		CHECK(isHit(matcher, hits[1], "help", 9, 9));
+		CHECK(isHit(matcher, hits[2], "how can I help you", 6, 10));
+		// the confidence is the minimum of the word confidences
+		CHECK_NEAR(hits[0].confidence, 0.85, 1e-9);
+		CHECK_NEAR(hits[2].confidence, 0.80, 1e-9);
+	}
+
+	// without word confidences the utterance confidence is used
+	std::vector<PhraseHit> hits2;
+	std::string wordBuffer;
+	matcher.match(u.words, u.startTimes, u.endTimes, SPL::list<SPL::float64>(), 0.5, hits2, wordBuffer);
+	CHECK(hits2.size() == 3);
+	for (const PhraseHit & hit : hits2)
+		CHECK(hit.confidence == 0.5);
+
+	// the word times are required
+	std::vector<PhraseHit> hits3;
+	matcher.match(u.words, u.startTimes, SPL::list<SPL::float64>(), u.confidences, 0.5, hits3, wordBuffer);
+	CHECK(hits3.empty());
+}
+
+void testOverlapping() {
+	const PhraseMatcher matcher(std::vector<std::string>{"a b", "b c", "a b c", "b", "c d e", "b c d e f"});
+	const std::vector<PhraseHit> hits = match(matcher, Utterance(std::vector<std::string>{"a", "b", "c", "d", "e", "x"}));
+	// all overlapping phrases are reported, the longest first for the same last word
+	CHECK(hits.size() == 5);
+	if (hits.size() == 5) {
+		CHECK(isHit(matcher, hits[0], "a b", 0, 1));
+		CHECK(isHit(matcher, hits[1], "b", 1, 1));
+		CHECK(isHit(matcher, hits[2], "a b c", 0, 2));
+		CHECK(isHit(matcher, hits[3], "b c", 1, 2));
+		// the failure link of "b c d e" leads to "c d e"
+		CHECK(isHit(matcher, hits[4], "c d e", 2, 4));
+	}
+
+	// a repeated phrase is reported at each position
+	const PhraseMatcher repeat(std::vector<std::string>{"no no"});
+	const std::vector<PhraseHit> hits2 = match(repeat, Utterance(std::vector<std::string>{"no", "no", "no"}));
+	CHECK(hits2.size() == 2);
+	if (hits2.size() == 2) {
+		CHECK(isHit(repeat, hits2[0], "no no", 0, 1));
+		CHECK(isHit(repeat, hits2[1], "no no", 1, 2));
+	}
+}
+
+void testWordBoundaries() {
+	// the phrases match complete words only; the white space of a phrase separates its words
+	const PhraseMatcher matcher(std::vector<std::string>{"custom", "er serv", "service how", "  can\tI   help "});
+	const std::vector<PhraseHit> hits = match(matcher, Utterance(std::vector<std::string>{"customer", "service",
+		"how", "can", "I", "help"}));
+	CHECK(hits.size() == 2);
+	if (hits.size() == 2) {
+		CHECK(isHit(matcher, hits[0], "service how", 1, 2));
+		// the phrase text of the dictionary is the key of the result
+		CHECK(isHit(matcher, hits[1], "  can\tI   help ", 3, 5));
+	}
+	// an unknown word between the words of a phrase breaks the match
+	CHECK(match(matcher, Utterance(std::vector<std::string>{"service", "uh", "how"})).empty());
+}
+
+void testCaseFolding() {
+	const PhraseMatcher matcher(std::vector<std::string>{"Customer SERVICE", "customer service", "IBM"});
+	// a duplicate phrase after case folding is mapped to its first entry
+	CHECK(matcher.size() == 2);
+	const std::vector<PhraseHit> hits = match(matcher, Utterance(std::vector<std::string>{"cUSTOMER", "Service", "ibm"}));
+	CHECK(hits.size() == 2);
+	if (hits.size() == 2) {
+		CHECK(isHit(matcher, hits[0], "Customer SERVICE", 0, 1));
+		CHECK(isHit(matcher, hits[1], "IBM", 2, 2));
+	}
+	std::string buffer;
+	PhraseMatcher::normalize("ÄbC-9", 6, buffer);
+	// only the ASCII letters are folded
+	CHECK(buffer == "Äbc-9");
+}
+
+void testEmptyDictionary() {
+	const PhraseMatcher empty(std::vector<std::string>{});
+	CHECK(empty.size() == 0);
+	CHECK(match(empty, Utterance(std::vector<std::string>{"a", "b"})).empty());
+	// the phrases without words are ignored
+	const PhraseMatcher blank(std::vector<std::string>{"", "  ", "\t\r\n"});
+	CHECK(blank.size() == 0);
+	CHECK(match(blank, Utterance(std::vector<std::string>{"", " "})).empty());
+	// an empty utterance
+	const PhraseMatcher matcher(std::vector<std::string>{"a"});
+	CHECK(match(matcher, Utterance(std::vector<std::string>{})).empty());
+}
+
+void testProcessor() {
+	const PhraseMatcher matcher(std::vector<std::string>{"a b", "b", "c"});
+	const std::vector<PhraseHit> hits = match(matcher, Utterance(std::vector<std::string>{"a", "b", "x", "b"}));
+	SPL::map<SPL::rstring, SPL::list<PhraseEmergence> > results;
+	// the entries of the previous result without hits are erased
+	results["c"].resize(2);
+	results["b"].resize(3);
+	const PhraseProcessor proc(&matcher, hits);
+	proc.getPhraseSpottingResults(results);
+	CHECK(results.size() == 2);
+	CHECK(results.count("c") == 0);
+	CHECK(results["a b"].size() == 1);
+	CHECK(results["b"].size() == 2);
+	if (results["b"].size() == 2) {
+		CHECK(results["b"][0].startTime == 1.0);
+		CHECK(results["b"][1].startTime == 3.0);
+		CHECK(results["b"][1].endTime == 4.0);
+		CHECK_NEAR(results["b"][1].confidence, 0.87, 1e-9);
+	}
+
+	// the result type map<rstring, float64>
+	SPL::map<SPL::rstring, SPL::list<SPL::map<SPL::rstring, SPL::float64> > > mapResults;
+	proc.getPhraseSpottingResults(mapResults);
+	CHECK(mapResults.size() == 2);
+	if (mapResults["a b"].size() == 1) {
+		CHECK(mapResults["a b"][0]["start_time"] == 0.0);
+		CHECK(mapResults["a b"][0]["end_time"] == 2.0);
+		CHECK_NEAR(mapResults["a b"][0]["confidence"], 0.89, 1e-9);
+	}
+
+	// no hits and no dictionary clear the results
+	const std::vector<PhraseHit> noHits;
+	PhraseProcessor(&matcher, noHits).getPhraseSpottingResults(results);
+	CHECK(results.empty());
+	results["b"].resize(1);
+	PhraseProcessor().getPhraseSpottingResults(results);
+	CHECK(results.empty());
+}
+
+} // namespace
+
+int main() {
+	testMatch();
+	testOverlapping();
+	testWordBoundaries();
+	testCaseFolding();
+	testEmptyDictionary();
+	testProcessor();
+	return unittest::result("PhraseMatcherTest");
+}
@@ -0,0 +1,188 @@
+/*
+ * SpeakerProcessorTest.cpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Unit test of SpeakerProcessor
+ * The merge of the word list and the speaker labels is compared with the previous implementation, which looked up
+ * the from times in a hash map, on randomized lists. The times of the randomized lists are multiples of 0.01 seconds,
+ * like the times of the STT service, so that the exact match of the previous implementation and the match within
+ * the tolerance give the same result.
+ */
+
+#include <SPL/Runtime/Type/SPLType.h>
+#include <SPL/Runtime/Common/RuntimeDebug.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Decoder.hpp"
+#include "SpeakerProcessor.hpp"
+#include "TestConfig.hpp"
+#include "UnitTest.hpp"
+
+using namespace com::ibm::streams::sttgateway;
+
+namespace {
+
+struct SpeakerUpdate {
+	SPL::float64 startTime; SPL::int32 speaker; SPL::float64 confidence;
+	void set_startTime(SPL::float64 v) { startTime = v; }
+	void set_speaker(SPL::int32 v) { speaker = v; }
+	void set_confidence(SPL::float64 v) { confidence = v; }
+};
+
+struct Label {
+	int tick; // from time in units of 0.01 seconds
+	SPL::int32 speaker;
+	SPL::float64 confidence;
+};
+
+// The result of the merge
+struct Result {
+	SPL::list<SPL::int32> speakers;
+	SPL::list<SPL::float64> confidences;
+	std::vector<rapidjson::SizeType> updates;
+};
+
+std::string makePayload(const std::vector<Label> & labels) {
+	std::string payload = "{\"speaker_labels\": [";
+	char buffer[128];
+	for (size_t i = 0; i < labels.size(); ++i) {
+		std::snprintf(buffer, sizeof(buffer), "%s{\"from\": %d.%02d, \"to\": %d.%02d, \"speaker\": %d, \"confidence\": %.3f, \"final\": false}",
+				(i == 0) ? "" : ", ", labels[i].tick / 100, labels[i].tick % 100,
+				(labels[i].tick + 10) / 100, (labels[i].tick + 10) % 100, labels[i].speaker, labels[i].confidence);
+		payload += buffer;
+	}
+	payload += "]}";
+	return payload;
+}
+
+// The previous implementation of SpeakerProcessor::run
+Result referenceRun(const Decoder & dec, const SPL::list<SPL::float64> & wordStartTimes) {
+	const SPL::list<SPL::float64> & spkFrom = dec.DecoderSpeakerLabels::getFrom();
+	const SPL::list<SPL::int32> & spkSpk = dec.DecoderSpeakerLabels::getSpeaker();
+	const SPL::list<SPL::float64> & spkCfd = dec.DecoderSpeakerLabels::getConfidence();
+	const rapidjson::SizeType spkSize = dec.DecoderSpeakerLabels::getSize();
+	Result result;
+	std::unordered_map<SPL::float64, rapidjson::SizeType> spkIndexMap;
+	for (rapidjson::SizeType i = 0; i < spkSize; i++)
+		spkIndexMap.insert(std::pair<const SPL::float64, rapidjson::SizeType>(spkFrom[i], i));
+	std::unordered_set<rapidjson::SizeType> usedSpkIndexes;
+	for (size_t i = 0; i < wordStartTimes.size(); i++) {
+		auto it = spkIndexMap.find(wordStartTimes[i]);
+		if (it != spkIndexMap.end()) {
+			result.speakers.push_back(spkSpk[it->second]);
+			result.confidences.push_back(spkCfd[it->second]);
+			usedSpkIndexes.insert(it->second);
+		} else {
+			result.speakers.push_back(-1);
+			result.confidences.push_back(-1.0);
+		}
+	}
+	for (rapidjson::SizeType i = 0; i < spkSize; i++)
+		if (usedSpkIndexes.find(i) == usedSpkIndexes.end())
+			result.updates.push_back(i);
+	return result;
+}
+
+Result run(const Decoder & dec, const SPL::list<SPL::float64> & wordStartTimes, const std::string & payload) {
+	SpeakerProcessor spkproc(dec, wordStartTimes, "test", payload);
+	spkproc.run();
+	Result result;
+	result.speakers = spkproc.getUtteranceWordsSpeakers();
+	result.confidences = spkproc.getUtteranceWordsSpeakersConfidences();
+	// the updates are identified by their confidence, which is unique per label
+	const SPL::list<SpeakerUpdate> updates = spkproc.getUtteranceWordsSpeakerUpdates<SpeakerUpdate>();
+	const SPL::list<SPL::float64> & spkCfd = dec.DecoderSpeakerLabels::getConfidence();
+	for (const SpeakerUpdate & update : updates)
+		for (rapidjson::SizeType i = 0; i < spkCfd.size(); ++i)
+			if (spkCfd[i] == update.confidence)
+				result.updates.push_back(i);
+	return result;
+}
+
+bool equal(const Result & a, const Result & b) {
+	return (a.speakers == b.speakers) && (a.confidences == b.confidences) && (a.updates == b.updates);
+}
+
+void testRandomized(Decoder & dec) {
+	std::mt19937 random(4711);
+	const int cases = 20000;
+	int mismatches = 0;
+	int matchedWords = 0;
+	int unmatchedWords = 0;
+	size_t updates = 0;
+	for (int c = 0; c < cases; ++c) {
+		// sorted label ticks with duplicates
+		std::vector<Label> labels;
+		const int nLabels = std::uniform_int_distribution<int>(0, 12)(random);
+		int tick = std::uniform_int_distribution<int>(0, 5)(random);
+		for (int i = 0; i < nLabels; ++i) {
+			// the confidence is unique per label
+			labels.push_back(Label{tick, std::uniform_int_distribution<int>(0, 2)(random), static_cast<SPL::float64>(i + 1) / 100.0});
+			tick += std::uniform_int_distribution<int>(0, 4)(random);
+		}
+		const std::string payload = makePayload(labels);
+		dec.doWork(payload);
+		const SPL::list<SPL::float64> & spkFrom = dec.DecoderSpeakerLabels::getFrom();
+
+		// sorted word ticks with duplicates; the words with the tick of a label have the decoded from time of the label
+		SPL::list<SPL::float64> wordStartTimes;
+		const int nWords = std::uniform_int_distribution<int>(0, 12)(random);
+		tick = std::uniform_int_distribution<int>(0, 5)(random);
+		for (int i = 0; i < nWords; ++i) {
+			size_t l = 0;
+			while ((l < labels.size()) && (labels[l].tick != tick))
+				++l;
+			if (l < labels.size())
+				wordStartTimes.push_back(spkFrom[l]);
+			else
+				wordStartTimes.push_back(static_cast<SPL::float64>(tick) / 100.0);
+			tick += std::uniform_int_distribution<int>(0, 4)(random);
+		}
+
+		const Result expected = referenceRun(dec, wordStartTimes);
+		if ( ! equal(expected, run(dec, wordStartTimes, payload))) {
+			if (mismatches == 0)
+				std::cout << "first mismatch: " << payload << std::endl;
+			++mismatches;
+		}
+		for (SPL::int32 speaker : expected.speakers)
+			(speaker < 0) ? ++unmatchedWords : ++matchedWords;
+		updates += expected.updates.size();
+	}
+	CHECK(mismatches == 0);
+	// the lists cover words with and without speaker label and speaker updates
+	CHECK(matchedWords > cases);
+	CHECK(unmatchedWords > cases);
+	CHECK(updates > cases);
+}
+
+void testTolerance(Decoder & dec) {
+	// a label and a word start time which differ less than 5 ms match
+	const std::string payload = makePayload(std::vector<Label>{{100, 0, 0.5}, {200, 1, 0.6}, {300, 2, 0.7}});
+	dec.doWork(payload);
+	const SPL::list<SPL::float64> wordStartTimes{1.004, 1.996, 2.5};
+	const Result result = run(dec, wordStartTimes, payload);
+	CHECK((result.speakers == SPL::list<SPL::int32>{0, 1, -1}));
+	CHECK((result.confidences == SPL::list<SPL::float64>{0.5, 0.6, -1.0}));
+	// the label at 3.0 is not assigned to a word
+	CHECK((result.updates == std::vector<rapidjson::SizeType>{2}));
+}
+
+} // namespace
+
+int main() {
+	const WatsonSTTConfig config = unittest::makeConfig(SPL::list<SPL::rstring>());
+	Decoder dec(config);
+	testRandomized(dec);
+	testTolerance(dec);
+	return unittest::result("SpeakerProcessorTest");
+}
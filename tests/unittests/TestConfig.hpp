@@ -0,0 +1,42 @@
+/*
+ * TestConfig.hpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * The WatsonSTT configuration of the unit tests of the decoder and the result processors
+ */
+
+#ifndef STTGATEWAY_TESTCONFIG_HPP_
+#define STTGATEWAY_TESTCONFIG_HPP_
+
+#include <SPL/Runtime/Type/SPLType.h>
+
+#include "WatsonSTTConfig.hpp"
+
+namespace unittest {
+
+// The configuration in the order of the members of WatsonSTTConfig
+// The words, the speaker labels and the keyword results are decoded
+inline com::ibm::streams::sttgateway::WatsonSTTConfig makeConfig(const SPL::list<SPL::rstring> & keywords) {
+	using com::ibm::streams::sttgateway::WatsonSTTConfig;
+	return WatsonSTTConfig{
+		"test", 0, "test",
+		false, 0.0, 60.0, false, "wss://localhost", "en-US_NarrowbandModel", "audio/l16;rate=8000",
+		WatsonSTTConfig::partial, true, false, "", "", 9.9, "", false,
+		1, 0.0,                                  // maxUtteranceAlternatives, wordAlternativesThreshold
+		true, true, true,                        // wordConfidenceNeeded, wordTimestampNeeded, identifySpeakers
+		true, false, false,                      // speakerUpdatesNeeded, smartFormattingNeeded, redactionNeeded
+		keywords.empty() ? 0.0 : 0.3,            // keywordsSpottingThreshold
+		keywords,
+		false, 0.5, 0.0, 0.0,
+		false, 0, 25.0,                          // multiplexed, standbyConnections, standbyRefreshPeriod
+		65536, 0.0, false,                       // audioChunkSize, audioPacingFactor, utteranceLatencyNeeded
+		true, true, ! keywords.empty(),          // utteranceTextNeeded, utteranceWordsNeeded, keywordsSpottingResultsNeeded
+		false, "", "", 0.0                       // phraseSpottingResultsNeeded, phraseDictionaryFile, phraseDictionaryAppConfigName, phraseDictionaryReloadPeriod
+	};
+}
+
+} // namespace unittest
+
+#endif /* STTGATEWAY_TESTCONFIG_HPP_ */
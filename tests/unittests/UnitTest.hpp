@@ -0,0 +1,46 @@
+/*
+ * UnitTest.hpp
+ *
+ * Licensed Materials - Property of IBM
+ * Copyright IBM Corp. 2019, 2021
+ *
+ * Minimal check macros for the standalone unit tests
+ * A failed check prints the location and the expression; the test returns the number of failed checks.
+ */
+
+#ifndef STTGATEWAY_UNITTEST_HPP_
+#define STTGATEWAY_UNITTEST_HPP_
+
+#include <cmath>
+#include <iostream>
+
+namespace unittest {
+
+inline int & failures() {
+	static int n = 0;
+	return n;
+}
+
+inline void fail(const char * file, int line, const char * expr) {
+	std::cout << file << ":" << line << ": check failed: " << expr << std::endl;
+	++failures();
+}
+
+// print the result and get the exit code of the test
+inline int result(const char * name) {
+	if (failures() == 0)
+		std::cout << name << ": all checks passed" << std::endl;
+	else
+		std::cout << name << ": " << failures() << " checks failed" << std::endl;
+	return (failures() == 0) ? 0 : 1;
+}
+
+} // namespace unittest
+
+#define CHECK(expr) \
+	do { if ( ! (expr)) unittest::fail(__FILE__, __LINE__, #expr); } while (false)
+
+#define CHECK_NEAR(a, b, eps) \
+	do { if ( ! (std::fabs((a) - (b)) <= (eps))) unittest::fail(__FILE__, __LINE__, #a " near " #b); } while (false)
+
+#endif /* STTGATEWAY_UNITTEST_HPP_ */